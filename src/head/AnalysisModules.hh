@@ -17,6 +17,29 @@
 
 
 
+class AnalysisModules;
+
+typedef struct {
+	int id;
+	void (AnalysisModules::*kernel)(float);
+	void (AnalysisModules::*finish)(std::vector<Label>, std::vector<Label>);
+	std::vector<Label> samples;
+	std::vector<Label> selections;        // selections of the outputs
+	std::vector<Label> event_selections;  // selections parsed in the loop, none if the kernel sees every event
+	int number_of_selections;             // nominal event selections
+	int number_of_variations;             // kinematic variations of the event selections
+	std::vector<int> sample_indices;      // index in the pass of every sample of the fused loop, -1 if not used
+	std::vector<int> selection_indices;   // index in the pass of every selection of the fused loop, -1 if not used
+	std::vector<std::vector<std::map<AKROSD, int> > > event_count_cache;
+	std::vector<std::vector<TString> > event_lists_cache;
+	std::vector<std::vector<std::vector<H1D*> > > h1d_cache;
+	std::vector<std::vector<std::vector<H2D*> > > h2d_cache;
+	std::vector<std::map<Label, std::map<AKROSD, int> > > object_count_cache;
+	std::vector<std::vector<TString> > previous_outputs; // hash of every output read from an earlier run, "" if computed
+} ModulePass;
+
+
+
 class AnalysisModules: public Dileptons {
 
 public:
@@ -29,28 +52,86 @@ public:
 	virtual ~AnalysisModules();
 	virtual void Initialize();
 
-	void CallModuleByID(int);
+	std::vector<Label> AddKinematicVariations(std::vector<Label>);
+	void AddModulePass(int, void (AnalysisModules::*)(float), void (AnalysisModules::*)(std::vector<Label>, std::vector<Label>), std::vector<Label>, std::vector<Label>, std::vector<Label>);
+	void CallModuleByID(int, bool = false);
 	void EndDileptons();
+	std::vector<Label> GetModuleDefinitionsByID(int);
+	std::vector<Label> GetModuleInputsByID(int);
+	std::vector<Label> GetModuleOutputsByID(int);
+	void RunModulePasses();
 	void RunModules();
-	void LoopOverEntries(void (AnalysisModules::*)(float), Label);
-	void LoopOverEntries(void (AnalysisModules::*)(float), Label, std::vector<Label>);
+	virtual void EndLoopPhase(LoopPhase);
+	virtual void LoopOverEntries(void (AnalysisModules::*)(float), Label);
+	virtual void LoopOverEntries(void (AnalysisModules::*)(float), Label, std::vector<Label>);
 	void LoopOverSamples(void (AnalysisModules::*)(float), std::vector<Label>, std::vector<Label>);
 	void DefineOutputCache(int, std::vector<Label>, std::vector<Label>, std::vector<Label>, std::vector<Label>);
-	void WriteOutputCache(int, std::vector<Label>, std::vector<Label>);
+	virtual void WriteOutputCache(int, std::vector<Label>, std::vector<Label>);
+
+	void ModulePassEntryKernel(float);
+	void ModulePassKernel(float);
 
 	void Module11Frame();
 	void Module11Kernel(float);
+	void Module11Finish(std::vector<Label>, std::vector<Label>);
 	void Module12Frame();
 	void Module12Kernel(float);
+	void Module12Finish(std::vector<Label>, std::vector<Label>);
 	void Module13Frame();
 	void Module13Kernel(float);
+	void Module16Frame();
+	void Module16Kernel(float);
+	void Module16Finish(std::vector<Label>, std::vector<Label>);
+	void Module36Frame();
+	void Module36Kernel(float);
+	void Module36Finish(std::vector<Label>, std::vector<Label>);
+	void Module41Frame();
+	void Module41Kernel(float);
+	void Module41Finish(std::vector<Label>, std::vector<Label>);
+	void Module42Frame();
+	void Module42Kernel(float);
+	void Module42Finish(std::vector<Label>, std::vector<Label>);
 
 
 
 private:
 
 
+	void CallModulePassKernel(ModulePass &, int, int, float);
+	void FillFakePrediction(int, float);
+	void FindModulePassOutputs(std::vector<Label> &, std::vector<Label> &);
+	TString GetOutputHash(int, Label, Label);
+	bool IsModuleNeeded(int, std::vector<int>);
+	bool IsModuleReady(int, std::vector<int>);
+	bool IsOutputRead(int, int);
+	void LoadPreviousOutputs(int);
+	void ReadModulePassOutputs(std::vector<Label>);
+	void StartModuleWorker(std::vector<int>);
+	bool StartModuleWorkers();
+	void SwapModulePassCache(ModulePass &);
+	bool WaitForModuleWorkers(int);
+
+	bool kClosureTest;
+	CutScan kCutScan;
+	std::vector<float> kCutScanValues;
 	Long64_t kEntryIterator;
+	void (AnalysisModules::*kEntryKernel)(float);
+	std::vector<ModulePass> kModulePasses;
+	int kModulePassSelections;
+	std::vector<Label> kModuleProducts;
+	std::vector<pid_t> kModuleWorkers;
+	std::vector<std::vector<int> > kModuleWorkerIDs;         // modules of every running worker
+	std::vector<std::vector<int> > kModuleWorkerQueue;       // groups of modules waiting for a worker
+	TString kOutputHashKey;                                  // configuration entering every output
+	TString kOutputHashInputKey;                             // configuration entering the outputs of modules with inputs
+	std::map<TString, std::vector<TString> > kPreviousOutputs; // outputs of earlier runs by hash: ROOT file and histogram names
+	std::vector<int> kPreviousOutputModules;
+	std::vector<std::vector<TString> > kReadOutputs;          // outputs of the pass being finished read from an earlier run
+	FakeRatioMap kElectronFakeRatioMap;
+	FakeRatioMap kMuonFakeRatioMap;
+	std::vector<float> kPredictionWeights;
+	std::vector<float> kFakeRatioJetThresholds;
+	std::vector<bool> kFakeRatioTrigger;
 	
 };
 
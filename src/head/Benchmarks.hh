@@ -0,0 +1,53 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef BENCHMARKS_HH
+#define BENCHMARKS_HH
+
+#include <sys/resource.h>
+
+#include "src/head/AnalysisModules.hh"
+
+
+class Benchmarks: public AnalysisModules {
+
+public:
+
+
+	// Member Functions
+
+	Benchmarks(TString);
+	virtual ~Benchmarks();
+	virtual void Initialize();
+
+	void EndLoopPhase(LoopPhase);
+	void WriteOutputCache(int, std::vector<Label>, std::vector<Label>);
+
+	static long GetPeakMemory();
+	static double GetTime();
+	static TString PrintReportHeader();
+	TString PrintReport(TString, int);
+	void RunBenchmark(int);
+
+
+
+private:
+
+	Long64_t kNumberOfEvents;
+	double kModuleTime;
+	double kPhaseStart;
+	double kPhaseTimes[5];
+	
+};
+
+
+#endif
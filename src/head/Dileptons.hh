@@ -46,13 +46,22 @@
 
 #include "src/head/Base.hh"
 #include "src/helper/AnalysisTools.hh"
+#include "src/helper/Arena.hh"
+#include "src/helper/Bootstrap.hh"
+#include "src/helper/ColumnStore.hh"
+#include "src/helper/CutScan.hh"
 #include "src/helper/CustomTypes.hh"
 #include "src/helper/DataSample.hh"
 #include "src/helper/Debug.hh"
+#include "src/helper/FakeRatioMap.hh"
+#include "src/helper/FileOperations.hh"
 #include "src/helper/H1D.hh"
 #include "src/helper/H2D.hh"
 #include "src/helper/OtherInput.hh"
 #include "src/helper/OtherOutput.hh"
+#include "src/helper/Profiler.hh"
+#include "src/helper/RenderQueue.hh"
+#include "src/helper/SelectionBitmap.hh"
 #include "src/helper/Style.hh"
 #include "src/helper/Tools.hh"
 #include "src/helper/Verbose.hh"
@@ -70,17 +79,23 @@ public:
 	Dileptons(TString);
 	virtual ~Dileptons();
 	virtual void Initialize();
-	bool CheckAKROSDStringForDefinedVariables(Label, AKROSD, std::vector<Label>, std::vector<Label>);
-	bool CheckAKROSDStringForEventSelection(AKROSD, std::vector<Label>, std::vector<Label>);
-	bool CheckAKROSDStringForObjectSelection(Label, AKROSD, std::vector<Label>, std::vector<Label>);
+	bool CheckAKROSDStringForDefinedVariables(Label, AKROSD, const std::vector<Label> &, const std::vector<Label> &);
+	bool CheckAKROSDStringForEventSelection(AKROSD, const std::vector<Label> &, const std::vector<Label> &);
+	bool CheckAKROSDStringForObjectSelection(Label, AKROSD, const std::vector<Label> &, const std::vector<Label> &);
 	void CheckConfiguration();
 	void CheckResources();
+	void CloseDerivedColumns();
+	void CloseEventTrees();
 	void CloseRootTree();
+	void CloseSelectionBitmap();
 	void CreateTemporaryConfigurationFile(TString);
 	void CreateOutputStructure();
 	void EndDileptons();
 	void FillEventList();
+	void FillEventTree();
+	void FillSelectionBitmap();
 	void FinalizeOutput();
+	TString GetDefinitionHash(Label, Label);
 	int GetKinematicObjectIteratorByLabel(Label);
 	TString GetKinematicObjectTypeByLabel(Label);
 	TString GetOutputContent(Label, Label);
@@ -88,8 +103,13 @@ public:
 	TString GetOutputContent(Label, Label, Label, Label);
 	TString GetOutputFolder(int);
 	TString GetOutputName(int, OutputType, TString, Label = "multiple", Label = "none");
+	TString GetSampleIdentity(Label);
 	void LoadConfigurationFile(TString);
+	void OpenDerivedColumns(Label);
+	void OpenEventTrees(Label, std::vector<Label>);
 	void OpenRootTree(TString);
+	void OpenSelectionBitmap(Label, std::vector<Label>);
+	void PublishModuleOutput(int);
 	void SetConfigplot(TString);
 	void SetVersion();
 	void StartDileptons(TString);
@@ -98,9 +118,9 @@ public:
 
 	Label GetAKROSDLabelInStatement(AKROSD);
 	std::vector<Label> GetAKROSDLabelsInIfThElStatement(AKROSD);
-	std::vector<AKROSD> GetAKROSDStatements(AKROSD, AKROSD = ",", AKROSD = "|");
-	std::vector<float> GetAnalysisToolsArgumentList(Label);
-	std::vector<float> GetVectorOfParseResults(AKROSD, std::vector<AKROSD>, int = 0);
+	ArenaTStringVector GetAKROSDStatements(AKROSD, AKROSD = ",", AKROSD = "|");
+	ArenaFloatVector GetAnalysisToolsArgumentList(Label);
+	ArenaFloatVector GetVectorOfParseResults(AKROSD, const ArenaTStringVector &, int = 0);
 	AKROSD InterpretAKROSDBrackets(AKROSD, Label);
 	AKROSD InterpretAKROSDIfThElStatements(AKROSD, Label);
 	AKROSD InterpretAKROSDRangeStatements(AKROSD, Label);
@@ -126,13 +146,28 @@ public:
 	void CountKinematicObjects(Label);
 	void CountSelectedKinematicObjects();
 
+	void ApplyKinematicVariation(int);
+	void CleanJets();
+	void ComputeEventWeights(float, float);
 	float ComputeMT(Label, int);	
+	void FillJetCleaningTable(const std::vector<float> &, const std::vector<float> &, float);
 	int FindKinematicObjects(AKROSD);
+	float GetJetPt(int);
+	static float GetJetResolution(float, float);
+	float GetMET();
+	float GetMETPhi();
+	Float_t * GetWeightBranch(Label);
+	bool IsCleanJet(int);
+	void ParseDefinedVariable(Label, int = 0);
+	void ReadDerivedColumns();
 	bool RecreateDefinedVariable(Label);
 	void ResetDefinedVariables();
 	void ResetKinematicObjects();
+	void SetKinematicVariations();
+	void SetWeightVariations();
+	void WriteDerivedColumns();
 
-	std::vector<float> ParseVariableDefinition(AKROSD, int = 0);
+	ArenaFloatVector ParseVariableDefinition(AKROSD, int = 0);
 	bool ParseEventSelection(AKROSD);
 	bool ParseObjectSelection(AKROSD, Label);
 	void PrepareEventSelection();
@@ -153,13 +188,39 @@ public:
 	DileptonsRunOn cRunOn;
 	TString cModules;
 	int cModuleList;
+	TString cPlotFormats;
+	int cRenderWorkers;
+	bool cSeparateOutputFiles;
+	bool cProfileAKROSD;
+	int cProgressInterval;
+	bool cFuseModules;
+	int cModuleWorkers;
+	TString cSkimSelections;
+	TString cSkimBranches;
+	TString cSkimVariables;
+	int cSkimCompression;
+	int cDerivedColumns;
+	bool cIncrementalRuns;
+	bool cSelectionBitmaps;
 	float cLuminosity;
 	int cJetEnergyCorrection;
 	bool cPileUpReweighting;
+	TString cCleaningObjects;
+	float cCleaningDeltaR;
+	int cBootstrapReplicas;
+	TString cFakeRatioMap;
+	TString cScanVariables;
+	TString cScanSelections;
+	TString cScanRegions;
+	TString cServerSocket;
+	TString cServerSamples;
+	int cServerMemory;
 	std::map <Label, AKROSD> cDefinedVariableDefinitions;
 	std::map <Label, AKROSD> cEventSelectionDefinitions;
 	std::map <Label, AKROSD> cObjectSelectionDefinitions;
 	std::map <Label, DataSample*> cSamples;
+	std::map <Label, TString> cWeightDefinitions;
+	std::map <Label, TString> cKinematicVariationDefinitions;
 
 
 	// Folders and Files
@@ -193,26 +254,51 @@ public:
 
 	TString kTemporaryFileConfiguration;
 	TString kTemporaryFileLog;
-	TString kTemporaryFileTag;
 
 
 	// Other Member Variables
 
-	TCanvas * kCanvas;
+	Arena * kArena;
+	ColumnStore * kColumnStore;
 	TString kConfigplot;
+	Profiler * kProfiler;
+	RenderQueue * kRenderQueue;
 	TTree * kRootTree;
+	SelectionBitmap * kSelectionBitmap;
 	Verbose * kVerbose;
 	TString kVersion;
 
 	std::vector <int> kModules;
 	std::vector <std::pair<Label, TString> > kBasicKinematicObjects;
-	std::map <Label, std::vector<int> > kKinematicObjects;
+	std::map <Label, ArenaIntVector> kKinematicObjects;
 	std::map <Label, int> kNumberOfKinematicObjects;
-	std::map <Label, std::vector<float> > kDefinedVariables;
+	std::map <Label, ArenaFloatVector> kDefinedVariables;
+
+	std::vector<Label> kCleaningObjects;
+	bool kJetCleaningDone;
+	std::vector<JetCleaning> kJetCleaningTable;
+	std::vector<bool> kCleanJets;
+
+	std::vector<Label> kWeightNames;
+	std::vector<std::vector<Float_t*> > kWeightFactors;
+	std::vector<float> kEventWeights;
+
+	std::vector<Label> kKinematicVariationNames;
+	std::vector<KinematicVariation> kKinematicVariations;
+	int kKinematicVariationIterator;
+	std::vector<float> kVariedJetPt;
+	float kVariedMET;
+	float kVariedMETPhi;
+	bool kIsData;
 
 	std::vector<std::vector<std::map<AKROSD, int> > > kEventCountCache;
 	std::vector<std::vector<TString> > kEventListsCache;
 	std::vector<std::vector<TTree*> > kEventTreeCache;
+	std::vector<Label> kSkims;
+	std::vector<Label> kSkimVariables;
+	std::vector<std::vector<float>*> kSkimVariableValues;
+	std::vector<Label> kSelectionBitmapSamples;
+	std::map<Label, bool> kSelectionResults;
 	std::vector<std::vector<std::vector<H1D*> > > kH1DCache;
 	std::vector<std::vector<std::vector<H2D*> > > kH2DCache;
 	std::vector<std::map<Label, std::map<AKROSD, int> > > kObjectCountCache;
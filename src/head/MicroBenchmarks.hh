@@ -0,0 +1,63 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef MICROBENCHMARKS_HH
+#define MICROBENCHMARKS_HH
+
+#include "src/head/Benchmarks.hh"
+#include "src/head/Dileptons.hh"
+#include "src/helper/AnalysisTools.hh"
+#include "src/helper/SyntheticSample.hh"
+
+
+
+class MicroBenchmarks: public Dileptons {
+
+public:
+
+
+	// Member Functions
+
+	MicroBenchmarks(TString, int = 100, unsigned int = 4357);
+	virtual ~MicroBenchmarks();
+	void Initialize(int, unsigned int);
+
+	void BenchmarkAnalysisTools(int);
+	void BenchmarkDefinedVariables(int);
+	void BenchmarkEventSelections(int);
+	void BenchmarkNesting(int);
+	void BenchmarkObjectSelections(int);
+	void BenchmarkPreparation(int);
+	void BenchmarkVariables(int);
+	void RunBenchmarks(int);
+
+	static int GetNestingDepth(AKROSD);
+	static TString PrintReportHeader();
+	TString PrintReport();
+
+
+
+private:
+
+	void AddResult(TString, TString, AKROSD, long, double);
+	double GetTimerOverhead();
+	void LoadEvent(int);
+
+	std::vector<SyntheticSample*> kEvents;
+	std::vector<TString> kResults;
+	volatile float kSink;
+	double kTimerOverhead;
+
+};
+
+
+#endif
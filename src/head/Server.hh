@@ -0,0 +1,60 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef SERVER_HH
+#define SERVER_HH
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "src/head/AnalysisModules.hh"
+
+
+class Server: public AnalysisModules {
+
+public:
+
+
+	// Member Functions
+
+	Server(TString);
+	virtual ~Server();
+	virtual void Initialize();
+
+	void EndDileptons();
+	void Serve();
+
+
+
+private:
+
+	TString CheckRequest(std::vector<Label> &, std::vector<Label> &, std::vector<TString> &);
+	TString HandleRequest(TString);
+	void LoadSamples();
+	TString ReadRequest(int);
+	TString RunRequest(std::vector<Label>, std::vector<Label>, std::vector<TString>);
+	bool WriteResponse(int, TString);
+
+	std::map<Label, TFile*> kServerFiles;
+	std::map<Label, TTree*> kServerTrees;
+	TString kServerSocket;
+	
+};
+
+
+#endif
@@ -94,50 +94,37 @@ float AnalysisTools::DeltaR(float eta1, float eta2, float phi1, float phi2){
 
 
 //__________________________________________________________________________
-float AnalysisTools::Maximum(std::vector<float> vector){
+int AnalysisTools::GetLeptonOrigin(int mid, int gmid){
 	/*
-  	returns the maximum element of a vector of floats, if size larger than 0,
-  	otherwise it returns 0.0
- 	parameters: vector
- 	return: maximum element
- 	*/
-
-	if(vector.size() == 0) return 0.;
-
-	return *std::max_element(vector.begin(), vector.end());
-
-}
-
-
-//__________________________________________________________________________
-float AnalysisTools::Minimum(std::vector<float> vector){
-	/*
-  	returns the minimum element of a vector of floats, if size larger than 0,
-  	otherwise it returns 0.0
-  	parameters: vector
-  	return: minimum element
-  	*/
-
-	if(vector.size() == 0) return 0.;
-
-	return *std::min_element(vector.begin(), vector.end());
-
-}
-
-
-//__________________________________________________________________________
-float AnalysisTools::Sum(std::vector<float> summands){
-	/*
-	computes the sum over the elements in a vector
-	parameters: summands
-	return: sum
+	returns the origin of a lepton given the PDG IDs of its mother and
+	grandmother
+	parameters: mid (mother id), gmid (grandmother id)
+	return: 1 (W or top, prompt), 2 (bottom), 3 (charm), 4 (light flavor), 
+	        5 (unidentified)
 	*/
 
-	float sum = 0.;
-	for(int i = 0; i < summands.size(); ++i)
-		sum += summands[i];
-
-	return sum;
+	int mother           = abs(mid);
+	int grandmother      = abs(gmid);
+	int mother_3dig      = mother % 1000;
+	int grandmother_3dig = grandmother % 1000;
+
+	if      (mother == 24 || grandmother == 24                                                               ) return 1;
+	else if (mother == 5 || grandmother == 5                                                                 ) return 2;
+	else if (grandmother >= 5000 && grandmother <= 5999                                                      ) return 2;
+	else if ((grandmother < 1000 || grandmother > 9999) && grandmother_3dig >= 500 && grandmother_3dig <= 599) return 2;
+	else if (mother >= 5000 && mother <= 5999                                                                ) return 2;
+	else if ((mother < 1000 || mother > 9999) && mother_3dig >= 500 && mother_3dig <= 599                    ) return 2;
+	else if (mother == 4 || grandmother == 4                                                                 ) return 3;
+	else if (grandmother >= 4000 && grandmother <= 4999                                                      ) return 3;
+	else if ((grandmother < 1000 || grandmother > 9999) && grandmother_3dig >= 400 && grandmother_3dig <= 499) return 3;
+	else if (mother >= 4000 && mother <= 4999                                                                ) return 3;
+	else if ((mother < 1000 || mother > 9999) && mother_3dig >= 400 && mother_3dig <= 499                    ) return 3;
+	else if (grandmother == 1 || grandmother == 2 || grandmother == 3                                        ) return 4;
+	else if (mother == 1 || mother == 2 || mother == 3                                                       ) return 4;
+	else if (mother_3dig >= 100 && mother_3dig <= 399                                                        ) return 4;
+	else if (mother == 6 || grandmother == 6                                                                 ) return 1;
+
+	return 5;
 
 }
 
@@ -18,6 +18,7 @@
 #include <TString.h>
 #include <TMath.h>
 
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 #include <iostream>
@@ -34,14 +35,67 @@
 
 namespace AnalysisTools {
 
+	// Non-template members
+
 	float Absolute(float);
 	float AngleAddition(float, float);
 	float AngleSubtraction(float, float);
 	float DeltaPhi(float, float);
 	float DeltaR(float, float, float, float);
-	float Maximum(std::vector<float>);
-	float Minimum(std::vector<float>);
-	float Sum(std::vector<float>);
+	int GetLeptonOrigin(int, int);
+
+	// Template members, they take any vector of floats, i.e. also the ones
+	// whose memory comes from the arena of the event
+
+
+	//__________________________________________________________________________
+	template<typename VectorType> float Maximum(const VectorType & vector){
+		/*
+	  	returns the maximum element of a vector of floats, if size larger than 0,
+	  	otherwise it returns 0.0
+	 	parameters: vector
+	 	return: maximum element
+	 	*/
+
+		if(vector.size() == 0) return 0.;
+
+		return *std::max_element(vector.begin(), vector.end());
+
+	}
+
+
+	//__________________________________________________________________________
+	template<typename VectorType> float Minimum(const VectorType & vector){
+		/*
+	  	returns the minimum element of a vector of floats, if size larger than 0,
+	  	otherwise it returns 0.0
+	  	parameters: vector
+	  	return: minimum element
+	  	*/
+
+		if(vector.size() == 0) return 0.;
+
+		return *std::min_element(vector.begin(), vector.end());
+
+	}
+
+
+	//__________________________________________________________________________
+	template<typename VectorType> float Sum(const VectorType & summands){
+		/*
+		computes the sum over the elements in a vector
+		parameters: summands
+		return: sum
+		*/
+
+		float sum = 0.;
+		for(int i = 0; i < summands.size(); ++i)
+			sum += summands[i];
+
+		return sum;
+
+	}
+
 
 }
 
@@ -0,0 +1,166 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/Arena.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CLASS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+Arena::Arena(size_t block_size){
+	/*
+	constructs the Arena class, a bump allocator for the transient vectors and
+	strings that are created while an event is evaluated; all of them are given
+	back at once when the arena is reset for the next event
+	parameters: block_size (bytes of every block)
+	return: none
+	*/
+
+	kBlockSize = block_size;
+	kBlock     = 0;
+	kOffset    = 0;
+	kUsed      = 0;
+
+	AddBlock(kBlockSize);
+
+}
+
+
+//____________________________________________________________________________
+Arena::~Arena(){
+	/*
+	destructs the Arena class and frees all blocks
+	parameters: none
+	return: none
+	*/
+
+	for(int i = 0; i < kBlocks.size(); ++i)
+		free(kBlocks[i]);
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR ALLOCATING MEMORY                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void Arena::AddBlock(size_t size){
+	/*
+	adds a new block at the end of the arena
+	parameters: size (bytes)
+	return: none
+	*/
+
+	char * block = (char *) malloc(size);
+	if(block == 0) throw std::bad_alloc();
+
+	kBlocks    .push_back(block);
+	kBlockSizes.push_back(size);
+
+}
+
+
+//____________________________________________________________________________
+void * Arena::Allocate(size_t size){
+	/*
+	returns memory for size bytes, aligned to 16 bytes; if the current block is
+	full we continue with the next one and only add a block if none is left, so
+	once the arena has grown to the size of the largest event nothing is
+	allocated on the heap anymore
+	parameters: size (bytes)
+	return: pointer to the memory
+	*/
+
+	size_t offset = (kOffset + 15) & ~((size_t) 15);
+
+	while(offset + size > kBlockSizes[kBlock]){
+		kUsed += kOffset;
+		if(kBlock + 1 == kBlocks.size()) AddBlock(size > kBlockSize ? size : kBlockSize);
+		++kBlock;
+		kOffset = 0;
+		offset  = 0;
+	}
+
+	kOffset = offset + size;
+
+	return kBlocks[kBlock] + offset;
+
+}
+
+
+//____________________________________________________________________________
+void Arena::Reset(){
+	/*
+	gives back all memory at once by moving to the beginning of the first block,
+	the blocks are kept for the next event
+	parameters: none
+	return: none
+	*/
+
+	kBlock  = 0;
+	kOffset = 0;
+	kUsed   = 0;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR GETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+size_t Arena::GetCapacity(){
+	/*
+	returns the number of bytes reserved by all blocks
+	parameters: none
+	return: capacity
+	*/
+
+	size_t capacity = 0;
+	for(int i = 0; i < kBlockSizes.size(); ++i)
+		capacity += kBlockSizes[i];
+
+	return capacity;
+
+}
+
+
+//____________________________________________________________________________
+size_t Arena::GetSize(){
+	/*
+	returns the number of bytes handed out since the last reset
+	parameters: none
+	return: size
+	*/
+
+	return kUsed + kOffset;
+
+}
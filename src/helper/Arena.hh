@@ -0,0 +1,119 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef ARENA_HH
+#define ARENA_HH
+
+#include "TROOT.h"
+#include "TString.h"
+
+#include <new>
+#include <stddef.h>
+#include <stdlib.h>
+#include <vector>
+
+
+
+class Arena{
+
+public:
+
+	// Member Functions
+
+	Arena(size_t = 65536);
+	~Arena();
+
+	void * Allocate(size_t);
+	void Reset();
+
+	size_t GetCapacity();
+	size_t GetSize();
+
+
+private:
+
+	void AddBlock(size_t);
+
+	size_t kBlockSize;
+	std::vector<char*> kBlocks;
+	std::vector<size_t> kBlockSizes;
+	int kBlock;     // block that is currently filled
+	size_t kOffset; // first free byte in the current block
+	size_t kUsed;   // bytes in the blocks before the current one
+
+};
+
+
+
+//____________________________________________________________________________
+template<typename ValueType> class ArenaAllocator{
+	/*
+	STL allocator taking its memory from an Arena; deallocating is a no-op,
+	the memory is given back all at once when the arena is reset; without an
+	arena it falls back to the heap, such that default constructed containers
+	behave like the ordinary ones
+	*/
+
+public:
+
+	typedef ValueType         value_type;
+	typedef ValueType *       pointer;
+	typedef const ValueType * const_pointer;
+	typedef ValueType &       reference;
+	typedef const ValueType & const_reference;
+	typedef size_t            size_type;
+	typedef ptrdiff_t         difference_type;
+
+	template<typename OtherType> struct rebind { typedef ArenaAllocator<OtherType> other; };
+
+	ArenaAllocator(Arena * arena = 0) : kArena(arena) {}
+	template<typename OtherType> ArenaAllocator(const ArenaAllocator<OtherType> & other) : kArena(other.GetArena()) {}
+
+	Arena * GetArena() const { return kArena; }
+
+	pointer address(reference value) const { return &value; }
+	const_pointer address(const_reference value) const { return &value; }
+	size_type max_size() const { return size_t(-1) / sizeof(ValueType); }
+
+	pointer allocate(size_type n, const void * = 0){
+		if(kArena == 0) return static_cast<pointer>(::operator new(n * sizeof(ValueType)));
+		return static_cast<pointer>(kArena -> Allocate(n * sizeof(ValueType)));
+	}
+
+	void deallocate(pointer p, size_type){
+		if(kArena == 0) ::operator delete(p);
+	}
+
+	void construct(pointer p, const ValueType & value) { new(p) ValueType(value); }
+	void destroy(pointer p) { p -> ~ValueType(); }
+
+	template<typename OtherType> bool operator==(const ArenaAllocator<OtherType> & other) const { return kArena == other.GetArena(); }
+	template<typename OtherType> bool operator!=(const ArenaAllocator<OtherType> & other) const { return kArena != other.GetArena(); }
+
+
+private:
+
+	Arena * kArena;
+
+};
+
+
+
+// vectors of the event evaluation, they use the heap unless they are
+// constructed with an arena
+
+typedef std::vector<float  , ArenaAllocator<float  > > ArenaFloatVector;
+typedef std::vector<int    , ArenaAllocator<int    > > ArenaIntVector;
+typedef std::vector<TString, ArenaAllocator<TString> > ArenaTStringVector;
+
+
+#endif
@@ -0,0 +1,114 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/Bootstrap.hh"
+
+
+
+
+//____________________________________________________________________________
+ULong64_t Bootstrap::GetEventKey(int run, int lumi, int event){
+	/*
+	combines run, lumi section and event number into one key, which seeds the
+	bootstrap weights of the event; the same event thus gets the same weights
+	in every job, whatever the order or the number of jobs is
+	parameters: run, lumi, event
+	return: key of the event
+	*/
+
+	ULong64_t key = Hash((ULong64_t) (unsigned int) run);
+	key = Hash(key ^ (ULong64_t) (unsigned int) lumi);
+	key = Hash(key ^ (ULong64_t) (unsigned int) event);
+
+	return key;
+
+}
+
+
+//____________________________________________________________________________
+double Bootstrap::GetGaussian(ULong64_t key, int counter){
+	/*
+	draws a standard normal number for a key and a counter (Box-Muller on two
+	hashes), such that e.g. the smearing of a jet does not depend on the order
+	or the number of events processed before
+	parameters: key (e.g. of the event and the variation), counter (e.g. the jet)
+	return: normal number with mean 0 and width 1
+	*/
+
+	ULong64_t hash = Hash(key + (ULong64_t) counter * 0x9E3779B97F4A7C15ULL);
+
+	double uniform1 = ((double) (hash         >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+	double uniform2 = ((double) (Hash(hash)   >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+
+	return sqrt(-2. * log(uniform1)) * cos(2. * M_PI * uniform2);
+
+}
+
+
+//____________________________________________________________________________
+int Bootstrap::GetPoissonWeight(ULong64_t key, int replica){
+	/*
+	draws the Poisson(1) weight of a replica for an event; the random number is
+	the hash of the event key and the replica number (counter-based), so there
+	is no generator state to share or to keep in sync
+	parameters: key (of the event), replica
+	return: weight, i.e. how often the event appears in the replica
+	*/
+
+	// cumulative Poisson(1) distribution
+	static const double cumulative[8] = {0.3678794, 0.7357589, 0.9196986, 0.9810118, 0.9963402, 0.9994058, 0.9999168, 0.9999898};
+
+	double uniform = (double) (Hash(key + (ULong64_t) replica * 0x9E3779B97F4A7C15ULL) >> 11) * (1.0 / 9007199254740992.0);
+
+	for(int k = 0; k < 8; ++k)
+		if(uniform < cumulative[k]) return k;
+
+	return 8;
+
+}
+
+
+//____________________________________________________________________________
+void Bootstrap::GetReplicaWeights(int run, int lumi, int event, int replicas, float event_weight, std::vector<float> & weights){
+	/*
+	appends the weights of all bootstrap replicas of the event, i.e. the event
+	weight times its Poisson(1) weight in the replica
+	parameters: run, lumi, event, replicas (number of replicas), event_weight,
+	            weights (vector the replica weights are appended to)
+	return: none
+	*/
+
+	ULong64_t key = GetEventKey(run, lumi, event);
+
+	for(int i = 0; i < replicas; ++i)
+		weights.push_back(event_weight * GetPoissonWeight(key, i));
+
+}
+
+
+//____________________________________________________________________________
+ULong64_t Bootstrap::Hash(ULong64_t value){
+	/*
+	mixes the bits of a 64 bit number (the finalizer of SplitMix64), such that
+	neighbouring inputs give uncorrelated outputs
+	parameters: value
+	return: hash
+	*/
+
+	value += 0x9E3779B97F4A7C15ULL;
+	value  = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value  = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+	return value ^ (value >> 31);
+
+}
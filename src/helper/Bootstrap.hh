@@ -0,0 +1,35 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#ifndef BOOTSTRAP_HH
+#define BOOTSTRAP_HH
+
+#include <TROOT.h>
+
+#include <math.h>
+
+#include <vector>
+
+
+
+namespace Bootstrap {
+
+	ULong64_t GetEventKey(int, int, int);
+	double GetGaussian(ULong64_t, int);
+	int GetPoissonWeight(ULong64_t, int);
+	void GetReplicaWeights(int, int, int, int, float, std::vector<float> &);
+	ULong64_t Hash(ULong64_t);
+
+}
+
+#endif
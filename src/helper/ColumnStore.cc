@@ -0,0 +1,343 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/ColumnStore.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CLASS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+ColumnStore::ColumnStore(){
+	/*
+	constructs the ColumnStore class, which keeps the objects and defined
+	variables of every entry of a sample as columns in files next to the output,
+	one file per definition; a later run with the same definition reads them
+	instead of evaluating the AKROSD strings again
+	parameters: none
+	return: none
+	*/
+
+	kFolder  = "";
+	kEntries = 0;
+	kOpen    = false;
+
+}
+
+
+//____________________________________________________________________________
+ColumnStore::~ColumnStore(){
+	/*
+	destructs the ColumnStore class, open columns are closed
+	parameters: none
+	return: none
+	*/
+
+	Close();
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR OPENING AND CLOSING COLUMNS                            **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void ColumnStore::AddColumn(Label label, TString hash, bool object){
+	/*
+	adds the column of an object or defined variable; if a file for the same
+	definition holds at least the entries of the sample, the column is read from
+	it, else it is computed in this run and written to a temporary file first,
+	such that an incomplete or concurrently written column is never read
+	parameters: label, hash (of the definition), object (true for objects, false
+	            for defined variables)
+	return: none
+	*/
+
+	if(!kOpen) return;
+
+	Column column;
+	column.label          = label;
+	column.path           = kFolder + label + "_" + hash + ".root";
+	column.temporary_path = column.path + Form(".%d.tmp", (int) getpid());
+	column.object         = object;
+	column.precomputed    = false;
+	column.file           = 0;
+	column.tree           = 0;
+	column.values         = new std::vector<float>();
+	column.indices        = new std::vector<int>();
+
+	TDirectory * directory = gDirectory;
+
+
+	// column of an earlier run
+
+	if(FileOperations::ExistsFile(Tools::ConvertTStringToStdString(column.path))){
+		column.file = TFile::Open(column.path);
+		if(column.file != 0 && !column.file -> IsZombie()) column.tree = (TTree *) column.file -> Get("Columns");
+		if(column.tree != 0 && column.tree -> GetEntries() >= kEntries){
+			if(object) column.tree -> SetBranchAddress("indices", &column.indices);
+			else       column.tree -> SetBranchAddress("values" , &column.values );
+			column.precomputed = true;
+		}
+		else if(column.file != 0) {
+			column.file -> Close();
+			delete column.file;
+			column.file = 0;
+			column.tree = 0;
+		}
+	}
+
+
+	// column computed in this run
+
+	if(!column.precomputed){
+		column.file = new TFile(column.temporary_path, "RECREATE");
+		if(column.file -> IsZombie()) {
+			delete column.file;
+			column.file = 0;
+		}
+		else {
+			column.tree = new TTree("Columns", label + " " + hash);
+			if(object) column.tree -> Branch("indices", &column.indices);
+			else       column.tree -> Branch("values" , &column.values );
+		}
+	}
+
+	if(directory != 0) directory -> cd();
+
+	if(column.tree == 0) {
+		delete column.values;
+		delete column.indices;
+		return;
+	}
+
+	kColumns.push_back(column);
+
+}
+
+
+//____________________________________________________________________________
+void ColumnStore::Close(){
+	/*
+	closes all columns; the columns computed in this run are only kept if they
+	have a value for every entry of the sample
+	parameters: none
+	return: none
+	*/
+
+	for(int i = 0; i < kColumns.size(); ++i)
+		CloseColumn(kColumns[i]);
+
+	kColumns.clear();
+	kOpen = false;
+
+}
+
+
+//____________________________________________________________________________
+void ColumnStore::CloseColumn(Column & column){
+	/*
+	closes a column and moves a complete new column to its place
+	parameters: column
+	return: none
+	*/
+
+	bool complete = !column.precomputed && column.tree -> GetEntries() == kEntries;
+
+	if(!column.precomputed){
+		column.file -> cd();
+		column.tree -> Write("", TObject::kOverwrite);
+	}
+
+	column.file -> Close();
+	delete column.file;
+
+	if(!column.precomputed){
+		std::string temporary_path = Tools::ConvertTStringToStdString(column.temporary_path);
+		if(!complete || !FileOperations::MoveFile(temporary_path, Tools::ConvertTStringToStdString(column.path)))
+			FileOperations::RemoveFile(temporary_path);
+	}
+
+	delete column.values;
+	delete column.indices;
+
+}
+
+
+//____________________________________________________________________________
+void ColumnStore::Open(TString folder, Long64_t entries){
+	/*
+	opens the store of a sample, any columns still open are closed before
+	parameters: folder (of the sample), entries (that are looped over)
+	return: none
+	*/
+
+	Close();
+
+	kFolder  = folder;
+	kEntries = entries;
+	kOpen    = FileOperations::CreateDirectory(Tools::ConvertTStringToStdString(folder));
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR READING AND WRITING ENTRIES                            **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void ColumnStore::FillEntry(Long64_t entry){
+	/*
+	appends the current values to the columns computed in this run; the entries
+	have to come in order, entries that were filled already are skipped
+	parameters: entry
+	return: none
+	*/
+
+	for(int i = 0; i < kColumns.size(); ++i)
+		if(!kColumns[i].precomputed && kColumns[i].tree -> GetEntries() == entry)
+			kColumns[i].tree -> Fill();
+
+}
+
+
+//____________________________________________________________________________
+void ColumnStore::ReadEntry(Long64_t entry){
+	/*
+	reads an entry of the columns of earlier runs
+	parameters: entry
+	return: none
+	*/
+
+	for(int i = 0; i < kColumns.size(); ++i)
+		if(kColumns[i].precomputed)
+			kColumns[i].tree -> GetEntry(entry);
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR GETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+std::vector<int> * ColumnStore::GetIndices(int column){
+	/*
+	returns the buffer of the object indices of a column
+	parameters: column
+	return: indices
+	*/
+
+	return kColumns[column].indices;
+
+}
+
+
+//____________________________________________________________________________
+Label ColumnStore::GetLabel(int column){
+	/*
+	returns the label of the object or defined variable of a column
+	parameters: column
+	return: label
+	*/
+
+	return kColumns[column].label;
+
+}
+
+
+//____________________________________________________________________________
+int ColumnStore::GetNumberOfColumns(){
+	/*
+	returns the number of open columns
+	parameters: none
+	return: number of columns
+	*/
+
+	return kColumns.size();
+
+}
+
+
+//____________________________________________________________________________
+std::vector<float> * ColumnStore::GetValues(int column){
+	/*
+	returns the buffer of the values of a column
+	parameters: column
+	return: values
+	*/
+
+	return kColumns[column].values;
+
+}
+
+
+//____________________________________________________________________________
+bool ColumnStore::IsObject(int column){
+	/*
+	returns true if a column holds the indices of selected objects
+	parameters: column
+	return: true (objects), false (defined variable)
+	*/
+
+	return kColumns[column].object;
+
+}
+
+
+//____________________________________________________________________________
+bool ColumnStore::IsOpen(){
+	/*
+	returns true if the store of a sample is open
+	parameters: none
+	return: true (if open), false (else)
+	*/
+
+	return kOpen;
+
+}
+
+
+//____________________________________________________________________________
+bool ColumnStore::IsPrecomputed(int column){
+	/*
+	returns true if a column is read from an earlier run
+	parameters: column
+	return: true (read), false (computed in this run)
+	*/
+
+	return kColumns[column].precomputed;
+
+}
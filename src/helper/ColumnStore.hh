@@ -0,0 +1,80 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef COLUMNSTORE_HH
+#define COLUMNSTORE_HH
+
+#include "TROOT.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "src/helper/CustomTypes.hh"
+#include "src/helper/FileOperations.hh"
+#include "src/helper/Tools.hh"
+
+
+
+class ColumnStore{
+
+public:
+
+	// Member Functions
+
+	ColumnStore();
+	~ColumnStore();
+
+	void AddColumn(Label, TString, bool);
+	void Close();
+	void FillEntry(Long64_t);
+	void Open(TString, Long64_t);
+	void ReadEntry(Long64_t);
+
+	std::vector<int> * GetIndices(int);
+	Label GetLabel(int);
+	int GetNumberOfColumns();
+	std::vector<float> * GetValues(int);
+	bool IsObject(int);
+	bool IsOpen();
+	bool IsPrecomputed(int);
+
+
+private:
+
+	typedef struct {
+		Label label;
+		TString path;                // file of the column, named by label and hash
+		TString temporary_path;      // file the column is written to before it is complete
+		bool object;                 // indices of selected objects (else values of a defined variable)
+		bool precomputed;            // read from an earlier run (else computed and written)
+		TFile * file;
+		TTree * tree;
+		std::vector<float> * values;
+		std::vector<int> * indices;
+	} Column;
+
+	void CloseColumn(Column &);
+
+	TString kFolder;
+	Long64_t kEntries;
+	bool kOpen;
+	std::vector<Column> kColumns;
+
+};
+
+
+#endif
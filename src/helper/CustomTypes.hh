@@ -37,7 +37,8 @@ typedef TString Label;
 enum DileptonsRunOn {
 	analysis,
 	modules,
-	sketches
+	sketches,
+	server
 };
 
 enum DileptonsMode {
@@ -56,6 +57,14 @@ enum HistogramMode {
 	published
 };
 
+enum LoopPhase {
+	reading,
+	collecting,
+	selecting,
+	filling,
+	writing
+};
+
 enum OutputType {
 	histogram,
 	list,
@@ -141,6 +150,37 @@ typedef struct {
     float pt    ;
 } Tau;
 
+typedef struct {
+	long   calls        ;
+	double total        ;
+	double minimum      ;
+	double maximum      ;
+	long   latencies[32]; // bin i counts calls taking [2^i, 2^(i+1)) ns
+} InstrumentationRecord;
+
+typedef struct {
+	TString key      ;
+	TString owner    ; // the definition a clause belongs to
+	double  start    ;
+	double  children ; // time spent in nested definitions and clauses
+} ProfilerFrame;
+
+typedef struct {
+	long   calls     ;
+	double inclusive ;
+	double exclusive ;
+} ProfilerRecord;
+
+typedef struct {
+	int   jet     ; // tree index of the closest jet, -1 if there is none
+	float delta_r ;
+} JetCleaning;
+
+typedef struct {
+	TString type      ; // JES (relative shift of the jet pt) or JER (smearing)
+	float   parameter ; // relative shift or scale factor of the jet resolution
+} KinematicVariation;
+
 
 
 
@@ -0,0 +1,511 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/CutScan.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CLASS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+CutScan::CutScan(){
+	/*
+	constructs the CutScan class, a grid of weighted event counts over the
+	scanned variables with a cell between every two candidate thresholds; once
+	the grid is accumulated, the yield of any rectangular region whose bounds
+	are thresholds is a sum over its 2^n corners, independent of its size
+	parameters: none
+	return: none
+	*/
+
+	Initialize();
+
+}
+
+
+//____________________________________________________________________________
+CutScan::~CutScan(){
+	/*
+	destructs the CutScan class
+	parameters: none
+	return: none
+	*/
+
+}
+
+
+//____________________________________________________________________________
+void CutScan::Initialize(){
+	/*
+	initializes the CutScan class without variables
+	parameters: none
+	return: none
+	*/
+
+	kVariables  .clear();
+	kThresholds .clear();
+	kExclusive  .clear();
+	kBinStrides .clear();
+	kSumStrides .clear();
+	kSums       .clear();
+	kSquares    .clear();
+
+	kNumberOfBins = 1;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR SETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+bool CutScan::SetContents(const std::vector<double> & sums, const std::vector<double> & squares){
+	/*
+	sets the weights and squared weights of every bin of the grid and
+	accumulates them along every variable, such that every entry of the
+	cumulative grid holds the sum of all bins below it
+	parameters: sums, squares (of the weights in every bin, see GetBin)
+	return: true (if the number of bins matches), false (else)
+	*/
+
+	if(sums.size() != kNumberOfBins || squares.size() != kNumberOfBins) return false;
+
+	int size = kSumStrides.back();
+
+	kSums   .assign(size, 0.);
+	kSquares.assign(size, 0.);
+
+
+	// every bin is put one entry up along every variable, the first entries stay
+	// empty and are the lower end of the regions starting at the lowest value
+
+	for(int b = 0; b < kNumberOfBins; ++b){
+		int index = 0;
+		for(int d = 0; d < kVariables.size(); ++d){
+			int position = (b / kBinStrides[d]) % (2 * kThresholds[d].size() + 1);
+			index += (position + 1) * kSumStrides[d];
+		}
+		kSums   [index] = sums   [b];
+		kSquares[index] = squares[b];
+	}
+
+
+	// accumulating along one variable after the other gives the sums of all bins
+	// that are below in every variable
+
+	for(int d = 0; d < kVariables.size(); ++d){
+		int length = 2 * kThresholds[d].size() + 2;
+		for(int i = 0; i < size; ++i){
+			if((i / kSumStrides[d]) % length == 0) continue;
+			kSums   [i] += kSums   [i - kSumStrides[d]];
+			kSquares[i] += kSquares[i - kSumStrides[d]];
+		}
+	}
+
+	return true;
+
+}
+
+
+//____________________________________________________________________________
+bool CutScan::SetVariables(TString definition){
+	/*
+	sets the scanned variables and their thresholds, given as a list like
+	MET:50,>>120;HT:200,>>400 with the thresholds of every variable in
+	ascending order; a threshold is a boundary between two cells, with a
+	plain number (or >) the threshold belongs to the upper cell, with >> to
+	the lower one; internally every threshold has both boundaries, such that
+	regions can use >, >>, < and << with any of them
+	parameters: definition
+	return: true (if the definition is legal), false (else)
+	*/
+
+	Initialize();
+
+	std::vector<TString> variables = Tools::ExplodeTString(definition, ";");
+
+	for(int i = 0; i < variables.size(); ++i){
+
+		std::vector<TString> parts = Tools::ExplodeTString(variables[i], ":");
+		if(parts.size() != 2 || parts[0].Length() == 0) return false;
+
+		std::vector<TString> thresholds = Tools::ExplodeTString(parts[1], ",");
+		if(thresholds.size() == 0) return false;
+
+		std::vector<float> values;
+		std::vector<bool> exclusive;
+
+		for(int k = 0; k < thresholds.size(); ++k){
+			TString threshold = thresholds[k];
+			bool is_exclusive = threshold.BeginsWith(">>");
+			if(threshold.BeginsWith(">")) threshold.ReplaceAll(">", "");
+			if(!threshold.IsFloat()) return false;
+			if(k > 0 && threshold.Atof() <= values.back()) return false;
+			values   .push_back(threshold.Atof());
+			exclusive.push_back(is_exclusive);
+		}
+
+		kVariables .push_back(parts[0]);
+		kThresholds.push_back(values);
+		kExclusive .push_back(exclusive);
+	}
+
+	if(kVariables.size() == 0) return false;
+
+
+	// strides of the grid and the cumulative grid, the latter has one more entry
+	// per variable
+
+	int sum_size = 1;
+
+	for(int d = 0; d < kVariables.size(); ++d){
+		kBinStrides.push_back(kNumberOfBins);
+		kSumStrides.push_back(sum_size);
+		kNumberOfBins *= 2 * kThresholds[d].size() + 1;
+		sum_size      *= 2 * kThresholds[d].size() + 2;
+		if(kNumberOfBins > 100000) return false;
+	}
+
+	kSumStrides.push_back(sum_size);
+
+	return true;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR GETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+int CutScan::GetBin(const std::vector<float> & values){
+	/*
+	returns the bin of the grid for the values of the scanned variables; along
+	every variable, the position counts the thresholds the value is above or
+	equal to plus the ones it is above, such that a value equal to a threshold
+	has a bin of its own
+	parameters: values (of the variables, in the order of the definition)
+	return: bin
+	*/
+
+	int bin = 0;
+
+	for(int d = 0; d < kVariables.size(); ++d){
+		int position = 0;
+		for(int k = 0; k < kThresholds[d].size(); ++k){
+			if(values[d] < kThresholds[d][k]) break;
+			position += (values[d] > kThresholds[d][k]) ? 2 : 1;
+		}
+		bin += position * kBinStrides[d];
+	}
+
+	return bin;
+
+}
+
+
+//____________________________________________________________________________
+int CutScan::GetNumberOfBins(){
+	/*
+	returns the number of bins of the grid
+	parameters: none
+	return: number of bins
+	*/
+
+	return kNumberOfBins;
+
+}
+
+
+//____________________________________________________________________________
+int CutScan::GetNumberOfRegionSets(){
+	/*
+	returns the number of region sets, i.e. of subsets of the thresholds that
+	divide the grid into regions; with more than 20 thresholds only the sets
+	of the first 20 are listed
+	parameters: none
+	return: number of region sets
+	*/
+
+	int thresholds = 0;
+	for(int d = 0; d < kThresholds.size(); ++d)
+		thresholds += kThresholds[d].size();
+
+	return 1 << (thresholds > 20 ? 20 : thresholds);
+
+}
+
+
+//____________________________________________________________________________
+int CutScan::GetNumberOfVariables(){
+	/*
+	returns the number of scanned variables
+	parameters: none
+	return: number of variables
+	*/
+
+	return kVariables.size();
+
+}
+
+
+//____________________________________________________________________________
+TString CutScan::GetRegionSet(int set){
+	/*
+	returns the thresholds of a region set in the syntax of the definition,
+	variables without thresholds are left out; every bit of the set stands for
+	one threshold, the ones of the first variable first
+	parameters: set
+	return: thresholds of the region set, none if it is the full grid
+	*/
+
+	TString region_set = "";
+	int bit = 0;
+
+	for(int d = 0; d < kVariables.size(); ++d){
+		TString thresholds = "";
+		for(int k = 0; k < kThresholds[d].size(); ++k, ++bit){
+			if(bit >= 20 || !(set & (1 << bit))) continue;
+			if(thresholds.Length() > 0) thresholds += ",";
+			thresholds += Form("%s%g", kExclusive[d][k] ? ">>" : "", kThresholds[d][k]);
+		}
+		if(thresholds.Length() == 0) continue;
+		if(region_set.Length() > 0) region_set += ";";
+		region_set += kVariables[d] + ":" + thresholds;
+	}
+
+	if(region_set.Length() == 0) return "none";
+
+	return region_set;
+
+}
+
+
+//____________________________________________________________________________
+void CutScan::GetRegionSetYields(int set, std::vector<float> & yields, std::vector<float> & errors){
+	/*
+	returns the yields and their statistical errors of all regions of a region
+	set, the regions of the first variable run fastest; every variable with m
+	thresholds in the set has m+1 regions, from below the lowest to above the
+	highest threshold
+	parameters: set, yields, errors
+	return: none
+	*/
+
+	yields.clear();
+	errors.clear();
+
+
+	// boundaries of the regions along every variable
+
+	std::vector<std::vector<int> > edges(kVariables.size());
+	int bit = 0;
+
+	for(int d = 0; d < kVariables.size(); ++d){
+		edges[d].push_back(0);
+		for(int k = 0; k < kThresholds[d].size(); ++k, ++bit)
+			if(bit < 20 && (set & (1 << bit))) edges[d].push_back(kExclusive[d][k] ? 2 * k + 2 : 2 * k + 1);
+		edges[d].push_back(2 * kThresholds[d].size() + 1);
+	}
+
+
+	// loop over the regions
+
+	std::vector<int> cell(kVariables.size(), 0);
+	std::vector<int> lower(kVariables.size());
+	std::vector<int> upper(kVariables.size());
+
+	while(true){
+		for(int d = 0; d < kVariables.size(); ++d){
+			lower[d] = edges[d][cell[d]    ];
+			upper[d] = edges[d][cell[d] + 1];
+		}
+
+		double square = GetBoxSum(kSquares, lower, upper);
+		yields.push_back(GetBoxSum(kSums, lower, upper));
+		errors.push_back(square > 0. ? sqrt(square) : 0.);
+
+		int d = 0;
+		for(; d < kVariables.size(); ++d){
+			if(++cell[d] < edges[d].size() - 1) break;
+			cell[d] = 0;
+		}
+		if(d == kVariables.size()) break;
+	}
+
+}
+
+
+//____________________________________________________________________________
+TString CutScan::GetVariable(int variable){
+	/*
+	returns the name of a scanned variable
+	parameters: variable
+	return: name of the variable
+	*/
+
+	return kVariables[variable];
+
+}
+
+
+//____________________________________________________________________________
+bool CutScan::GetYield(TString region, float & yield, float & error){
+	/*
+	returns the yield and its statistical error of a rectangular region given
+	in the AKROSD syntax, e.g. MET>50<120,#GJ=2,HT>>400; the region may only use
+	the scanned variables and their thresholds
+	parameters: region, yield, error
+	return: true (if the region can be taken from the grid), false (else)
+	*/
+
+	std::vector<int> lower;
+	std::vector<int> upper;
+
+	if(!ParseRegion(region, lower, upper)) return false;
+
+	double square = GetBoxSum(kSquares, lower, upper);
+	yield = GetBoxSum(kSums, lower, upper);
+	error = square > 0. ? sqrt(square) : 0.;
+
+	return true;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR SUMMING REGIONS                                        **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+double CutScan::GetBoxSum(const std::vector<double> & sums, const std::vector<int> & lower, const std::vector<int> & upper){
+	/*
+	returns the sum of the bins from lower (included) to upper (excluded) along
+	every variable by adding and subtracting the cumulative sums at the corners
+	of the region (inclusion-exclusion)
+	parameters: sums (cumulative grid), lower, upper (positions along every
+	            variable)
+	return: sum
+	*/
+
+	if(sums.size() == 0) return 0.;
+
+	for(int d = 0; d < kVariables.size(); ++d)
+		if(lower[d] >= upper[d]) return 0.;
+
+	double sum = 0.;
+
+	for(int corner = 0; corner < (1 << kVariables.size()); ++corner){
+		int index = 0;
+		int sign  = 1;
+		for(int d = 0; d < kVariables.size(); ++d){
+			if(corner & (1 << d)) index += upper[d] * kSumStrides[d];
+			else {
+				index += lower[d] * kSumStrides[d];
+				sign  *= -1;
+			}
+		}
+		sum += sign * sums[index];
+	}
+
+	return sum;
+
+}
+
+
+//____________________________________________________________________________
+bool CutScan::ParseRegion(TString region, std::vector<int> & lower, std::vector<int> & upper){
+	/*
+	translates a region in the AKROSD syntax into its positions on the grid;
+	along every variable, > t starts at the boundary of t, >> t after it, < t
+	ends after the boundary of t and << t before it, = t is the boundary alone
+	parameters: region, lower, upper (positions along every variable)
+	return: true (if the region only uses scanned variables and their
+	        thresholds), false (else)
+	*/
+
+	lower.assign(kVariables.size(), 0);
+	upper.clear();
+	for(int d = 0; d < kVariables.size(); ++d)
+		upper.push_back(2 * kThresholds[d].size() + 1);
+
+	std::vector<TString> clauses = Tools::ExplodeTString(region, ",");
+
+	for(int i = 0; i < clauses.size(); ++i){
+
+		TString clause   = clauses[i];
+		Ssiz_t  position = 0;
+		while(position < clause.Length() && TString("<>=!").First(clause[position]) == kNPOS) ++position;
+
+		TString variable = clause(0, position);
+		int d = 0;
+		for(; d < kVariables.size(); ++d)
+			if(kVariables[d] == variable) break;
+		if(d == kVariables.size() || position == clause.Length()) return false;
+
+
+		// every operation of the clause with its value
+
+		while(position < clause.Length()){
+
+			Ssiz_t length = (position + 1 < clause.Length() && clause[position] == clause[position + 1]) ? 2 : 1;
+			TString operation = clause(position, length);
+			position += length;
+
+			Ssiz_t start = position;
+			while(position < clause.Length() && TString("<>=!").First(clause[position]) == kNPOS) ++position;
+			TString value = clause(start, position - start);
+			if(!value.IsFloat()) return false;
+
+			int k = 0;
+			for(; k < kThresholds[d].size(); ++k)
+				if(kThresholds[d][k] == (float) value.Atof()) break;
+			if(k == kThresholds[d].size()) return false;
+
+			if     (operation == ">" ) lower[d] = TMath::Max(lower[d], 2 * k + 1);
+			else if(operation == ">>") lower[d] = TMath::Max(lower[d], 2 * k + 2);
+			else if(operation == "<" ) upper[d] = TMath::Min(upper[d], 2 * k + 2);
+			else if(operation == "<<") upper[d] = TMath::Min(upper[d], 2 * k + 1);
+			else if(operation == "=" ) {
+				lower[d] = TMath::Max(lower[d], 2 * k + 1);
+				upper[d] = TMath::Min(upper[d], 2 * k + 2);
+			}
+			else return false;
+		}
+	}
+
+	return true;
+
+}
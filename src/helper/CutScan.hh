@@ -0,0 +1,67 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef CUTSCAN_HH
+#define CUTSCAN_HH
+
+#include "TROOT.h"
+#include "TMath.h"
+#include "TString.h"
+
+#include <math.h>
+#include <vector>
+
+#include "src/helper/Tools.hh"
+
+
+
+class CutScan{
+
+public:
+
+	// Member Functions
+
+	CutScan();
+	~CutScan();
+	void Initialize();
+
+	bool SetContents(const std::vector<double> &, const std::vector<double> &);
+	bool SetVariables(TString);
+
+	int GetBin(const std::vector<float> &);
+	int GetNumberOfBins();
+	int GetNumberOfRegionSets();
+	int GetNumberOfVariables();
+	TString GetRegionSet(int);
+	void GetRegionSetYields(int, std::vector<float> &, std::vector<float> &);
+	TString GetVariable(int);
+	bool GetYield(TString, float &, float &);
+
+
+private:
+
+	double GetBoxSum(const std::vector<double> &, const std::vector<int> &, const std::vector<int> &);
+	bool ParseRegion(TString, std::vector<int> &, std::vector<int> &);
+
+	std::vector<TString> kVariables;
+	std::vector<std::vector<float> > kThresholds;
+	std::vector<std::vector<bool> > kExclusive;   // boundary given as >> (the threshold belongs to the lower cell)
+	std::vector<int> kBinStrides;                // first variable fastest
+	std::vector<int> kSumStrides;
+	std::vector<double> kSums;                   // cumulative sums of the weights, one more entry per variable
+	std::vector<double> kSquares;                // cumulative sums of the squared weights
+	int kNumberOfBins;
+
+};
+
+
+#endif
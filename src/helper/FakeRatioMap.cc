@@ -0,0 +1,212 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/FakeRatioMap.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CLASS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+FakeRatioMap::FakeRatioMap(){
+	/*
+	constructs the FakeRatioMap class, which keeps a fake ratio map in (pt, |eta|)
+	as a flat lookup table, such that applying it in the event loop does not
+	need any lookup in a ROOT histogram
+	parameters: none
+	return: none
+	*/
+
+	Initialize();
+
+}
+
+
+//____________________________________________________________________________
+FakeRatioMap::~FakeRatioMap(){
+	/*
+	destructs the FakeRatioMap class
+	parameters: none
+	return: none
+	*/
+
+}
+
+
+//____________________________________________________________________________
+void FakeRatioMap::Initialize(){
+	/*
+	initializes the FakeRatioMap class, the map is empty by default
+	parameters: none
+	return: none
+	*/
+
+	kEdgesPt .clear();
+	kEdgesEta.clear();
+	kRatios  .clear();
+	kWeights .clear();
+	kWidthPt  = 0.;
+	kWidthEta = 0.;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR SETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void FakeRatioMap::SetMap(TH2F * histogram){
+	/*
+	copies the contents of a fake ratio map with pt on the x and |eta| on the y
+	axis into the lookup table; the weight f/(1-f) of a loose-not-tight lepton
+	is computed once per bin, bins with f >= 1 do not give a prediction
+	parameters: histogram
+	return: none
+	*/
+
+	Initialize();
+	if(histogram == 0) return;
+
+	int bins_pt  = histogram -> GetNbinsX();
+	int bins_eta = histogram -> GetNbinsY();
+
+	for(int i = 1; i <= bins_pt + 1; ++i)
+		kEdgesPt.push_back(histogram -> GetXaxis() -> GetBinLowEdge(i));
+	for(int i = 1; i <= bins_eta + 1; ++i)
+		kEdgesEta.push_back(histogram -> GetYaxis() -> GetBinLowEdge(i));
+
+	// uniform axes are indexed directly, all others by a binary search
+
+	kWidthPt  = (kEdgesPt .back() - kEdgesPt .front()) / bins_pt;
+	kWidthEta = (kEdgesEta.back() - kEdgesEta.front()) / bins_eta;
+
+	for(int i = 1; i < kEdgesPt.size(); ++i)
+		if(fabs(kEdgesPt[i] - kEdgesPt[i-1] - kWidthPt) > 1e-4 * kWidthPt) kWidthPt = 0.;
+	for(int i = 1; i < kEdgesEta.size(); ++i)
+		if(fabs(kEdgesEta[i] - kEdgesEta[i-1] - kWidthEta) > 1e-4 * kWidthEta) kWidthEta = 0.;
+
+	// the table is stored pt-major
+
+	kRatios .resize(bins_pt * bins_eta);
+	kWeights.resize(bins_pt * bins_eta);
+
+	for(int i = 0; i < bins_pt; ++i){
+		for(int j = 0; j < bins_eta; ++j){
+			float ratio = histogram -> GetBinContent(i + 1, j + 1);
+			kRatios [i * bins_eta + j] = ratio;
+			kWeights[i * bins_eta + j] = (ratio < 1.) ? ratio / (1. - ratio) : 0.;
+		}
+	}
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR GETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+bool FakeRatioMap::IsEmpty(){
+	/*
+	returns true if no map has been set yet
+	parameters: none
+	return: true (if the map is empty), false (else)
+	*/
+
+	return kRatios.size() == 0;
+
+}
+
+
+//____________________________________________________________________________
+int FakeRatioMap::GetAxisBin(float value, const std::vector<float> & edges, float width){
+	/*
+	returns the bin of a value on one axis, values outside of the axis are
+	taken from the first or last bin
+	parameters: value, edges, width (bin width if the axis is uniform, 0 else)
+	return: bin (starting from 0)
+	*/
+
+	int bins = edges.size() - 1;
+	int bin;
+
+	if(width > 0.) bin = (int) ((value - edges.front()) / width);
+	else           bin = std::upper_bound(edges.begin(), edges.end(), value) - edges.begin() - 1;
+
+	if(bin < 0)     return 0;
+	if(bin >= bins) return bins - 1;
+
+	return bin;
+
+}
+
+
+//____________________________________________________________________________
+int FakeRatioMap::GetBin(float pt, float eta){
+	/*
+	returns the position of a lepton in the lookup table
+	parameters: pt, eta
+	return: bin
+	*/
+
+	return GetAxisBin(pt, kEdgesPt, kWidthPt) * (kEdgesEta.size() - 1) + GetAxisBin(fabs(eta), kEdgesEta, kWidthEta);
+
+}
+
+
+//____________________________________________________________________________
+float FakeRatioMap::GetRatio(float pt, float eta){
+	/*
+	returns the fake ratio f of a lepton
+	parameters: pt, eta
+	return: fake ratio, 0 (if the map is empty)
+	*/
+
+	if(IsEmpty()) return 0.;
+
+	return kRatios[GetBin(pt, eta)];
+
+}
+
+
+//____________________________________________________________________________
+float FakeRatioMap::GetWeight(float pt, float eta){
+	/*
+	returns the weight f/(1-f) with which a loose-not-tight lepton enters the
+	fake prediction
+	parameters: pt, eta
+	return: weight, 0 (if the map is empty)
+	*/
+
+	if(IsEmpty()) return 0.;
+
+	return kWeights[GetBin(pt, eta)];
+
+}
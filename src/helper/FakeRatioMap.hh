@@ -0,0 +1,57 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef FAKERATIOMAP_HH
+#define FAKERATIOMAP_HH
+
+#include "TROOT.h"
+#include "TH2.h"
+
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+
+
+class FakeRatioMap{
+
+public:
+
+	// Member Functions
+
+	FakeRatioMap();
+	~FakeRatioMap();
+	void Initialize();
+
+	void SetMap(TH2F *);
+
+	bool IsEmpty();
+	int GetBin(float, float);
+	float GetRatio(float, float);
+	float GetWeight(float, float);
+
+
+private:
+
+	int GetAxisBin(float, const std::vector<float> &, float);
+
+	std::vector<float> kEdgesPt;
+	std::vector<float> kEdgesEta;
+	float kWidthPt;  // bin width if the axis is uniform, 0 else
+	float kWidthEta;
+	std::vector<float> kRatios;
+	std::vector<float> kWeights;
+
+};
+
+
+#endif
@@ -0,0 +1,489 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/FileOperations.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** INTERNAL STRUCTURES FOR THE THREADED COPY AND THE PUBLISHING             **
+******************************************************************************
+*****************************************************************************/
+
+
+namespace {
+
+	// one instance is shared by all workers of a CopyDirectory call; the
+	// workers pick the next file to copy by incrementing kNextFile
+
+	struct CopyJob {
+		std::string kSource;
+		std::string kDestination;
+		const std::vector<std::string> * kFiles;
+		bool kVerify;
+		bool kSuccess;
+		unsigned int kNextFile;
+		pthread_mutex_t kMutex;
+	};
+
+	// the single publishing job that may run in the background
+
+	struct PublishJob {
+		std::string kSource;
+		std::string kDestination;
+		int kNumberOfThreads;
+		bool kSuccess;
+	};
+
+	pthread_t kPublishThread;
+	PublishJob * kPublishJob = NULL;
+
+	const size_t kBufferSize = 65536;
+
+
+	//____________________________________________________________________________
+	void * CopyWorker(void * argument){
+		/*
+		worker of the thread pool in CopyDirectory, copies files until the list
+		of files of the job is exhausted
+		parameters: argument (pointer to the CopyJob)
+		return: NULL
+		*/
+
+		CopyJob * job = (CopyJob *) argument;
+
+		while(true){
+
+			pthread_mutex_lock(&job -> kMutex);
+			unsigned int file_index = job -> kNextFile++;
+			pthread_mutex_unlock(&job -> kMutex);
+
+			if(file_index >= job -> kFiles -> size()) break;
+
+			const std::string & file = job -> kFiles -> at(file_index);
+			if(!FileOperations::CopyFile(job -> kSource + file, job -> kDestination + file, job -> kVerify)){
+				pthread_mutex_lock(&job -> kMutex);
+				job -> kSuccess = false;
+				pthread_mutex_unlock(&job -> kMutex);
+			}
+		}
+
+		return NULL;
+
+	}
+
+
+	//____________________________________________________________________________
+	void * PublishWorker(void * argument){
+		/*
+		body of the background thread started by PublishDirectory
+		parameters: argument (pointer to the PublishJob)
+		return: NULL
+		*/
+
+		PublishJob * job = (PublishJob *) argument;
+		job -> kSuccess = FileOperations::CopyDirectory(job -> kSource, job -> kDestination, job -> kNumberOfThreads, true);
+
+		return NULL;
+
+	}
+
+
+	//____________________________________________________________________________
+	std::string AppendSlash(std::string path){
+		/*
+		makes sure a directory path ends with a slash
+		parameters: path
+		return: path with trailing slash
+		*/
+
+		if(path.size() == 0 || path[path.size() - 1] != '/') path += "/";
+		return path;
+
+	}
+
+}
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** MEMBERS FOR SINGLE FILES AND DIRECTORIES                                 **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+unsigned int FileOperations::ComputeChecksum(std::string file_path){
+	/*
+	computes the Adler-32 checksum of the content of a file
+	parameters: file_path
+	return: the checksum, 0 if the file cannot be read
+	*/
+
+	int file = open(file_path.c_str(), O_RDONLY);
+	if(file < 0) return 0;
+
+	unsigned int a = 1, b = 0;
+	unsigned char buffer[kBufferSize];
+	ssize_t length;
+
+	while((length = read(file, buffer, kBufferSize)) > 0){
+		for(ssize_t i = 0; i < length; ++i){
+			a = (a + buffer[i]) % 65521;
+			b = (b + a) % 65521;
+		}
+	}
+
+	close(file);
+
+	return (b << 16) | a;
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::CopyFile(std::string source_path, std::string destination_path, bool verify){
+	/*
+	copies a file without calling the shell; the content is first written to a
+	temporary file next to the destination which is renamed once complete, i.e.
+	nobody ever sees a half-written destination file; if wanted, the written file
+	is synced to the disk and its checksum is compared to that of the source; it
+	is read back through the page cache, so this catches short or corrupted
+	writes of the copy but does not prove what the disk holds
+	parameters: source_path, destination_path, verify (true if the checksum is to
+	            be compared after copying)
+	return: true (if copied successfully), false (else)
+	*/
+
+	struct stat source_stat;
+	if(stat(source_path.c_str(), &source_stat) != 0) return false;
+
+	int source = open(source_path.c_str(), O_RDONLY);
+	if(source < 0) return false;
+
+	std::string temporary_path = destination_path + ".part";
+	int destination = open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, source_stat.st_mode & 0777);
+	if(destination < 0) {
+		close(source);
+		return false;
+	}
+
+	unsigned int a = 1, b = 0;
+	unsigned char buffer[kBufferSize];
+	ssize_t length;
+	bool success = true;
+
+	while(success && (length = read(source, buffer, kBufferSize)) > 0){
+		for(ssize_t i = 0; verify && i < length; ++i){
+			a = (a + buffer[i]) % 65521;
+			b = (b + a) % 65521;
+		}
+		ssize_t written = 0;
+		while(written < length){
+			ssize_t chunk = write(destination, buffer + written, length - written);
+			if(chunk < 0) { success = false; break; }
+			written += chunk;
+		}
+	}
+
+	if(length < 0) success = false;
+
+	close(source);
+	if(success && verify && fsync(destination) != 0) success = false;
+	if(close(destination) != 0) success = false;
+
+	if(success && verify && ComputeChecksum(temporary_path) != ((b << 16) | a)) success = false;
+	if(success && rename(temporary_path.c_str(), destination_path.c_str()) != 0) success = false;
+
+	if(!success) unlink(temporary_path.c_str());
+
+	return success;
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::CreateDirectory(std::string path, mode_t mode){
+	/*
+	creates a directory including all missing parent directories, i.e. it does
+	what mkdir -p does
+	parameters: path, mode (permissions of newly created directories)
+	return: true (if the directory exists afterwards), false (else)
+	*/
+
+	if(path.size() == 0) return false;
+
+	for(size_t position = 1; position <= path.size(); ++position){
+		if(position != path.size() && path[position] != '/') continue;
+		std::string partial = path.substr(0, position);
+		if(mkdir(partial.c_str(), mode) != 0 && errno != EEXIST) return false;
+	}
+
+	return ExistsDirectory(path);
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::ExistsDirectory(std::string path){
+	/*
+	checks if a directory exists
+	parameters: path
+	return: true (if it exists and is a directory), false (else)
+	*/
+
+	struct stat path_stat;
+	return stat(path.c_str(), &path_stat) == 0 && S_ISDIR(path_stat.st_mode);
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::ExistsFile(std::string path){
+	/*
+	checks if a regular file exists
+	parameters: path
+	return: true (if it exists and is a regular file), false (else)
+	*/
+
+	struct stat path_stat;
+	return stat(path.c_str(), &path_stat) == 0 && S_ISREG(path_stat.st_mode);
+
+}
+
+
+//____________________________________________________________________________
+void FileOperations::ListDirectory(std::string root, std::string relative_path, std::vector<std::string> & directories, std::vector<std::string> & files){
+	/*
+	collects recursively all sub-directories and files in a directory; all paths
+	are given relative to the root directory
+	parameters: root (directory to list, with trailing slash), relative_path (sub-
+	            directory currently listed, "" at the top level), directories (filled
+	            with the sub-directories), files (filled with the files)
+	return: none
+	*/
+
+	DIR * directory = opendir((root + relative_path).c_str());
+	if(directory == NULL) return;
+
+	struct dirent * entry;
+	while((entry = readdir(directory)) != NULL){
+
+		std::string name = entry -> d_name;
+		if(name == "." || name == "..") continue;
+
+		std::string relative_name = relative_path + name;
+		struct stat entry_stat;
+		if(lstat((root + relative_name).c_str(), &entry_stat) != 0) continue;
+
+		if(S_ISDIR(entry_stat.st_mode)){
+			directories.push_back(relative_name + "/");
+			ListDirectory(root, relative_name + "/", directories, files);
+		}
+		else if(S_ISREG(entry_stat.st_mode))
+			files.push_back(relative_name);
+	}
+
+	closedir(directory);
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::MoveFile(std::string source_path, std::string destination_path){
+	/*
+	moves a file by an atomic rename; if source and destination are on different
+	file systems, the file is copied (atomically as well) and the source removed
+	parameters: source_path, destination_path
+	return: true (if moved successfully), false (else)
+	*/
+
+	if(rename(source_path.c_str(), destination_path.c_str()) == 0) return true;
+	if(errno != EXDEV) return false;
+
+	return CopyFile(source_path, destination_path, true) && RemoveFile(source_path);
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::RemoveDirectory(std::string path){
+	/*
+	removes a directory and all of its content, i.e. it does what rm -r does
+	parameters: path
+	return: true (if the directory does not exist anymore), false (else)
+	*/
+
+	if(!ExistsDirectory(path)) return true;
+
+	path = AppendSlash(path);
+
+	std::vector<std::string> directories;
+	std::vector<std::string> files;
+	ListDirectory(path, "", directories, files);
+
+	bool success = true;
+
+	for(int i = 0; i < files.size(); ++i)
+		if(!RemoveFile(path + files[i])) success = false;
+
+	// sub-directories are listed parents first, so we remove them in reverse order
+	for(int i = directories.size() - 1; i >= 0; --i)
+		if(rmdir((path + directories[i]).c_str()) != 0) success = false;
+
+	if(rmdir(path.c_str()) != 0) success = false;
+
+	return success;
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::RemoveFile(std::string path){
+	/*
+	removes a single file
+	parameters: path
+	return: true (if the file does not exist anymore), false (else)
+	*/
+
+	return unlink(path.c_str()) == 0 || errno == ENOENT;
+
+}
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** MEMBERS FOR COPYING FOLDERS IN PARALLEL AND IN THE BACKGROUND            **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+bool FileOperations::CopyDirectory(std::string source_path, std::string destination_path, int number_of_threads, bool verify){
+	/*
+	copies a directory recursively, i.e. it does what cp -r does; the directory
+	structure is created first, then the files are distributed to a pool of
+	threads which copy them in parallel
+	parameters: source_path, destination_path, number_of_threads (size of the
+	            thread pool), verify (true if every copy is checked by checksum)
+	return: true (if everything was copied successfully), false (else)
+	*/
+
+	source_path      = AppendSlash(source_path);
+	destination_path = AppendSlash(destination_path);
+
+	std::vector<std::string> directories;
+	std::vector<std::string> files;
+	ListDirectory(source_path, "", directories, files);
+
+	if(!CreateDirectory(destination_path)) return false;
+	for(int i = 0; i < directories.size(); ++i)
+		if(!CreateDirectory(destination_path + directories[i])) return false;
+
+	if(files.size() == 0) return true;
+
+
+	// the thread pool never gets larger than the number of files
+
+	if(number_of_threads > (int) files.size()) number_of_threads = files.size();
+	if(number_of_threads < 1) number_of_threads = 1;
+
+	CopyJob job;
+	job.kSource      = source_path;
+	job.kDestination = destination_path;
+	job.kFiles       = &files;
+	job.kVerify      = verify;
+	job.kSuccess     = true;
+	job.kNextFile    = 0;
+	pthread_mutex_init(&job.kMutex, NULL);
+
+	std::vector<pthread_t> threads(number_of_threads);
+	std::vector<bool> started(number_of_threads, false);
+
+	for(int i = 0; i < number_of_threads; ++i)
+		started[i] = (pthread_create(&threads[i], NULL, CopyWorker, &job) == 0);
+
+	// if not a single thread could be started, we do the work ourselves
+	if(std::find(started.begin(), started.end(), true) == started.end())
+		CopyWorker(&job);
+
+	for(int i = 0; i < number_of_threads; ++i)
+		if(started[i]) pthread_join(threads[i], NULL);
+
+	pthread_mutex_destroy(&job.kMutex);
+
+	return job.kSuccess;
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::PublishDirectory(std::string source_path, std::string destination_path, int number_of_threads){
+	/*
+	starts copying a directory in a background thread and returns immediately,
+	so the caller can continue working while the copy is ongoing; only one
+	publishing is running at a time, i.e. we first wait for the previous one
+	parameters: source_path, destination_path, number_of_threads (size of the
+	            thread pool used for copying)
+	return: true (if the previous publishing was successful), false (else)
+	*/
+
+	bool previous_success = WaitForPublishing();
+
+	kPublishJob = new PublishJob();
+	kPublishJob -> kSource          = source_path;
+	kPublishJob -> kDestination     = destination_path;
+	kPublishJob -> kNumberOfThreads = number_of_threads;
+	kPublishJob -> kSuccess         = false;
+
+	// if no thread can be started, we publish synchronously
+	if(pthread_create(&kPublishThread, NULL, PublishWorker, kPublishJob) != 0){
+		PublishWorker(kPublishJob);
+		bool success = kPublishJob -> kSuccess;
+		delete kPublishJob;
+		kPublishJob = NULL;
+		return previous_success && success;
+	}
+
+	return previous_success;
+
+}
+
+
+//____________________________________________________________________________
+bool FileOperations::WaitForPublishing(){
+	/*
+	blocks until the publishing running in the background (if any) has finished
+	parameters: none
+	return: true (if there was none or it was successful), false (else)
+	*/
+
+	if(kPublishJob == NULL) return true;
+
+	pthread_join(kPublishThread, NULL);
+
+	bool success = kPublishJob -> kSuccess;
+	delete kPublishJob;
+	kPublishJob = NULL;
+
+	return success;
+
+}
@@ -0,0 +1,56 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef FILEOPERATIONS_HH
+#define FILEOPERATIONS_HH
+
+#include <TROOT.h>
+#include <TString.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "src/helper/Tools.hh"
+
+
+namespace FileOperations {
+
+	unsigned int ComputeChecksum(std::string);
+	bool CopyDirectory(std::string, std::string, int = 4, bool = true);
+	bool CopyFile(std::string, std::string, bool = true);
+	bool CreateDirectory(std::string, mode_t = 0755);
+	bool ExistsDirectory(std::string);
+	bool ExistsFile(std::string);
+	void ListDirectory(std::string, std::string, std::vector<std::string>&, std::vector<std::string>&);
+	bool MoveFile(std::string, std::string);
+	bool RemoveDirectory(std::string);
+	bool RemoveFile(std::string);
+
+	bool PublishDirectory(std::string, std::string, int = 4);
+	bool WaitForPublishing();
+
+}
+
+#endif
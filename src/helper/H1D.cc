@@ -61,6 +61,7 @@ void H1D::Initialize(int creation_time, HistogramMode mode, bool set_sumw2){
 	*/
 
 	kMode = mode;
+	kNumberOfReplicas = 0;
 	
 	std::string time_id = Tools::ConvertIntToStdString(creation_time);
 
@@ -196,6 +197,65 @@ TH1F * H1D::GetTH1(){
 }
 
 
+//____________________________________________________________________________
+TH1F * H1D::GetTH1(int variation){
+	/*
+	returns the TH1F of a weight variation, where 0 is the nominal one and i > 0
+	is the i-th variation given in SetVariations
+	parameters: variation
+	return: TH1F of the variation
+	*/
+
+	if(variation <= 0 || variation > kVariationTH1.size()) return kTH1;
+
+	return kVariationTH1[variation - 1];
+
+}
+
+
+//____________________________________________________________________________
+int H1D::GetNumberOfReplicas(){
+	/*
+	returns the number of bootstrap replicas that are filled together with the
+	nominal histogram
+	parameters: none
+	return: kNumberOfReplicas
+	*/
+
+	return kNumberOfReplicas;
+
+}
+
+
+//____________________________________________________________________________
+int H1D::GetNumberOfVariations(){
+	/*
+	returns the number of weight variations besides the nominal histogram
+	parameters: none
+	return: number of variations
+	*/
+
+	return kVariationTH1.size();
+
+}
+
+
+//____________________________________________________________________________
+float H1D::GetReplicaContent(int replica, int cell){
+	/*
+	returns the content of a bootstrap replica in a given cell, where cell is
+	the global bin number of the TH1F including under- and overflow
+	parameters: replica, cell
+	return: content
+	*/
+
+	if(kNumberOfReplicas == 0) return 0.;
+
+	return kReplicas[replica * (kReplicas.size() / kNumberOfReplicas) + cell];
+
+}
+
+
 
 
 /*****************************************************************************
@@ -216,6 +276,17 @@ void H1D::Divide(H1D * denominator_histogram, Option_t* option){
 
 	kTH1 -> Divide(kTH1, denominator_histogram -> GetTH1(), 1, 1, option);
 
+	for(int i = 0; i < kVariationTH1.size(); ++i)
+		kVariationTH1[i] -> Divide(kVariationTH1[i], denominator_histogram -> GetTH1(i + 1), 1, 1, option);
+
+	if(kNumberOfReplicas > 0 && denominator_histogram -> GetNumberOfReplicas() == kNumberOfReplicas){
+		int cells = kReplicas.size() / kNumberOfReplicas;
+		for(int i = 0; i < kReplicas.size(); ++i){
+			float denominator = denominator_histogram -> GetReplicaContent(i / cells, i % cells);
+			kReplicas[i] = (denominator != 0.) ? kReplicas[i] / denominator : 0.;
+		}
+	}
+
 }
 
 
@@ -247,6 +318,33 @@ void H1D::Fill(float variable_x, float event_weight){
 }
 
 
+//____________________________________________________________________________
+void H1D::Fill(float variable_x, const std::vector<float> & event_weights){
+	/*
+	fills the nominal TH1F with the first weight and every variation with the
+	following ones, such that all systematic variations are filled in one call
+	parameters: variable_x, event_weights (nominal weight first, then one per variation)
+	return: none
+	*/
+
+	kTH1 -> Fill(variable_x, event_weights[0]);
+
+	for(int i = 0; i < kVariationTH1.size(); ++i)
+		kVariationTH1[i] -> Fill(variable_x, event_weights[i + 1]);
+
+	// the replica weights follow the variations
+	if(kNumberOfReplicas > 0 && event_weights.size() >= kVariationTH1.size() + 1 + kNumberOfReplicas){
+		int cell   = kTH1 -> FindBin(variable_x);
+		int cells  = kReplicas.size() / kNumberOfReplicas;
+		int offset = kVariationTH1.size() + 1;
+		for(int i = 0; i < kNumberOfReplicas; ++i)
+			if(event_weights[offset + i] != 0.)
+				kReplicas[i * cells + cell] += event_weights[offset + i];
+	}
+
+}
+
+
 //____________________________________________________________________________
 void H1D::SetBins(int bins_x_number, float bins_x_minimum, float bins_x_maximum){
 	/*
@@ -257,6 +355,11 @@ void H1D::SetBins(int bins_x_number, float bins_x_minimum, float bins_x_maximum)
 
 	kTH1 -> SetBins(bins_x_number, bins_x_minimum, bins_x_maximum);
 
+	for(int i = 0; i < kVariationTH1.size(); ++i)
+		kVariationTH1[i] -> SetBins(bins_x_number, bins_x_minimum, bins_x_maximum);
+
+	SetReplicas(kNumberOfReplicas);
+
 } 
 
 
@@ -269,6 +372,27 @@ void H1D::SetBins(std::vector<Double_t> bins_x){
 	*/
 
 	kTH1 -> SetBins(bins_x.size() - 1, &bins_x[0]);
+
+	for(int i = 0; i < kVariationTH1.size(); ++i)
+		kVariationTH1[i] -> SetBins(bins_x.size() - 1, &bins_x[0]);
+
+	SetReplicas(kNumberOfReplicas);
+}
+
+
+//____________________________________________________________________________
+void H1D::SetReplicas(int replicas){
+	/*
+	reserves the bootstrap replicas of the histogram, one array of all cells
+	(including under- and overflow) per replica, stored one replica after the
+	other; they are cleared whenever the binning changes
+	parameters: replicas (number of replicas)
+	return: none
+	*/
+
+	kNumberOfReplicas = replicas;
+	kReplicas.assign(replicas * (kTH1 -> GetNbinsX() + 2), 0.);
+
 }
 
 
@@ -281,27 +405,114 @@ void H1D::SetSumw2(){
   	*/
 
 	kTH1 -> Sumw2();
+
+	for(int i = 0; i < kVariationTH1.size(); ++i)
+		kVariationTH1[i] -> Sumw2();
+
 }
 
 
 //____________________________________________________________________________
-bool H1D::Write(TCanvas * canvas){
+void H1D::SetVariations(std::vector<TString> names){
 	/*
-  	writes the histogram to the disk
-  	parameters: none
-  	return: true (if written successfully), false (else)
-  	*/
+	adds one copy of the TH1F per weight variation, which has the same binning
+	and is filled together with the nominal one
+	parameters: names (names of the variations)
+	return: none
+	*/
 
-	kTH1 -> Draw();
-	canvas -> SaveAs(Tools::ConvertStdStringToCString(Tools::ConvertTStringToStdString(kOutputPath) + Tools::ConvertTStringToStdString(kName) + ".png"));
-	canvas -> SaveAs(Tools::ConvertStdStringToCString(Tools::ConvertTStringToStdString(kOutputPath) + Tools::ConvertTStringToStdString(kName) + ".pdf"));
-	canvas -> SaveAs(Tools::ConvertStdStringToCString(Tools::ConvertTStringToStdString(kOutputPath) + Tools::ConvertTStringToStdString(kName) + ".root"));
-	canvas -> SaveAs(Tools::ConvertStdStringToCString(Tools::ConvertTStringToStdString(kOutputPath) + Tools::ConvertTStringToStdString(kName) + ".C"));
+	for(int i = 0; i < names.size(); ++i){
+		kVariationTH1.push_back((TH1F *) kTH1 -> Clone(Tools::ConvertStdStringToCString(Tools::ConvertTStringToStdString(kTH1 -> GetName()) + "_" + Tools::ConvertTStringToStdString(names[i]))));
+		kVariationNames.push_back(names[i]);
+	}
+
+}
+
+
+//____________________________________________________________________________
+bool H1D::ReadFromDirectory(TDirectory * directory, TString name){
+	/*
+	adds the contents of a histogram that WriteToDirectory has written under a
+	given name, together with its variations and replicas; the binning has to be
+	the same as the one of this histogram
+	parameters: directory, name
+	return: true (if all parts were found and added), false (else)
+	*/
+
+	if(directory == 0) return false;
+
+	TH1F * histogram = (TH1F *) directory -> Get(name);
+	if(histogram == 0 || histogram -> GetNbinsX() != kTH1 -> GetNbinsX()) return false;
+	kTH1 -> Add(histogram);
+
+	for(int i = 0; i < kVariationTH1.size(); ++i){
+		histogram = (TH1F *) directory -> Get(name + "_" + kVariationNames[i]);
+		if(histogram == 0) return false;
+		kVariationTH1[i] -> Add(histogram);
+	}
+
+	if(kNumberOfReplicas > 0){
+		int cells = kReplicas.size() / kNumberOfReplicas;
+		TH2F * replicas = (TH2F *) directory -> Get(name + "_bootstrap");
+		if(replicas == 0 || replicas -> GetNbinsX() != cells || replicas -> GetNbinsY() != kNumberOfReplicas) return false;
+		for(int i = 0; i < kReplicas.size(); ++i)
+			kReplicas[i] += replicas -> GetBinContent(i % cells + 1, i / cells + 1);
+	}
 
 	return true;
 
 }
 
 
+//____________________________________________________________________________
+bool H1D::Write(TCanvas * canvas, std::vector<TString> formats){
+	/*
+	writes the histogram to the disk in the given formats
+	parameters: canvas (the canvas to draw on), formats (file extensions, e.g. png)
+	return: true (if written successfully), false (else)
+	*/
 
+	std::string path = Tools::ConvertTStringToStdString(kOutputPath) + Tools::ConvertTStringToStdString(kName) + ".";
+	bool success = true;
+
+	canvas -> cd();
+	kTH1 -> Draw();
+
+	for(int i = 0; i < formats.size(); ++i){
+		canvas -> SaveAs(Tools::ConvertStdStringToCString(path + Tools::ConvertTStringToStdString(formats[i])));
+		success = FileOperations::ExistsFile(path + Tools::ConvertTStringToStdString(formats[i])) && success;
+	}
+
+	return success;
+
+}
 
+
+//____________________________________________________________________________
+bool H1D::WriteToDirectory(TDirectory * directory){
+	/*
+	writes the histogram to a directory of a ROOT file under its name
+	parameters: directory
+	return: true (if written successfully), false (else)
+	*/
+
+	if(directory == 0) return false;
+
+	directory -> WriteTObject(kTH1, kName);
+
+	for(int i = 0; i < kVariationTH1.size(); ++i)
+		directory -> WriteTObject(kVariationTH1[i], kName + "_" + kVariationNames[i]);
+
+	// the replicas are written as one TH2F with the cells on x and the replicas on y
+	if(kNumberOfReplicas > 0){
+		int cells = kReplicas.size() / kNumberOfReplicas;
+		TH2F * replicas = new TH2F(Tools::ConvertStdStringToCString(Tools::ConvertTStringToStdString(kTH1 -> GetName()) + "_bootstrap"), "bootstrap", cells, 0, cells, kNumberOfReplicas, 0, kNumberOfReplicas);
+		for(int i = 0; i < kReplicas.size(); ++i)
+			replicas -> SetBinContent(i % cells + 1, i / cells + 1, kReplicas[i]);
+		directory -> WriteTObject(replicas, kName + "_bootstrap");
+		delete replicas;
+	}
+
+	return true;
+
+}
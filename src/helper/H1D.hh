@@ -13,6 +13,7 @@
 #ifndef H1D_HH
 #define H1D_HH
 
+#include "src/helper/FileOperations.hh"
 #include "src/helper/Style.hh"
 #include "src/helper/Verbose.hh"
 
@@ -37,15 +38,24 @@ public:
 	TString GetName();
 	TString GetOutputPath();
 	TH1F * GetTH1();
+	TH1F * GetTH1(int);
+	int GetNumberOfReplicas();
+	int GetNumberOfVariations();
+	float GetReplicaContent(int, int);
 
 	void Divide(H1D*, Option_t* = "");
 	void Fill(float);
 	void Fill(float, float);
 	void SetBins(int, float, float);
 	void SetBins(std::vector<Double_t>);
+	void Fill(float, const std::vector<float> &);
+	void SetReplicas(int);
 	void SetSumw2();	
+	void SetVariations(std::vector<TString>);
 
-	bool Write(TCanvas *);
+	bool ReadFromDirectory(TDirectory *, TString);
+	bool Write(TCanvas *, std::vector<TString>);
+	bool WriteToDirectory(TDirectory *);
 
 
 private:
@@ -56,6 +66,10 @@ private:
 	TString kOutputPath;
 	TString kRootFilePath;
 	TH1F * kTH1;
+	std::vector<TH1F*> kVariationTH1;
+	std::vector<TString> kVariationNames;
+	int kNumberOfReplicas;
+	std::vector<float> kReplicas;
 	Verbose * kVerbose;
 	
 };
@@ -13,6 +13,7 @@
 #ifndef H2D_HH
 #define H2D_HH
 
+#include "src/helper/FileOperations.hh"
 #include "src/helper/Style.hh"
 #include "src/helper/Verbose.hh"
 
@@ -36,15 +37,24 @@ public:
 	TString GetName();
 	TString GetOutputPath();
 	TH2F * GetTH2();
+	TH2F * GetTH2(int);
+	int GetNumberOfReplicas();
+	int GetNumberOfVariations();
+	float GetReplicaContent(int, int);
 
 	void Divide(H2D*, Option_t* = "");
 	void Fill(float, float);
 	void Fill(float, float, float);
 	void SetBins(int, float, float, int, float, float);
 	void SetBins(std::vector<Double_t>, std::vector<Double_t>);
+	void Fill(float, float, const std::vector<float> &);
+	void SetReplicas(int);
 	void SetSumw2();	
+	void SetVariations(std::vector<TString>);
 
-	bool Write(TCanvas *);
+	bool ReadFromDirectory(TDirectory *, TString);
+	bool Write(TCanvas *, std::vector<TString>);
+	bool WriteToDirectory(TDirectory *);
 
 
 private:
@@ -55,6 +65,10 @@ private:
 	TString kOutputPath;
 	TString kRootFilePath;
 	TH2F * kTH2;
+	std::vector<TH2F*> kVariationTH2;
+	std::vector<TString> kVariationNames;
+	int kNumberOfReplicas;
+	std::vector<float> kReplicas;
 	Verbose * kVerbose;	
 
 };
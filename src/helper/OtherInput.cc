@@ -28,6 +28,33 @@ std::vector<TString> OtherInput::ReadColumnFromListFile(std::string file_path, i
 
 }
 
+
+
+//____________________________________________________________________________
+std::map<AKROSD, int> OtherInput::ReadCountsFromRootFile(TDirectory * directory, TString name){
+	/*
+	reads counts written by OtherOutput::WriteCountsToRootFile, i.e. a TH1I
+	whose bins are labeled by the keys
+	parameters: directory, name
+	return: counts (empty if not found)
+	*/
+
+	std::map<AKROSD, int> counts;
+
+	if(directory == 0) return counts;
+
+	TH1I * counter = (TH1I *) directory -> Get(name);
+	if(counter == 0) return counts;
+
+	for(int bin = 1; bin <= counter -> GetNbinsX(); ++bin){
+		AKROSD key = counter -> GetXaxis() -> GetBinLabel(bin);
+		if(key.Length() > 0) counts[key] = (int) counter -> GetBinContent(bin);
+	}
+
+	return counts;
+
+}
+
 	
 //____________________________________________________________________________
 TString OtherInput::ReadFromTextFile(std::string file_path){
@@ -37,6 +64,39 @@ TString OtherInput::ReadFromTextFile(std::string file_path){
 }
 
 
+//____________________________________________________________________________
+TString OtherInput::ReadListFromRootFile(TDirectory * directory, TString name){
+	/*
+	reads an event list written by OtherOutput::WriteListToRootFile back into
+	its text form
+	parameters: directory, name
+	return: content (one event per line, Run, Lumi and Event separated by tabs)
+	*/
+
+	TString content = "";
+
+	if(directory == 0) return content;
+
+	TTree * tree = (TTree *) directory -> Get(name);
+	if(tree == 0) return content;
+
+	int run, lumi, event;
+	tree -> SetBranchAddress("Run"  , &run  );
+	tree -> SetBranchAddress("Lumi" , &lumi );
+	tree -> SetBranchAddress("Event", &event);
+
+	for(Long64_t i = 0; i < tree -> GetEntries(); ++i){
+		tree -> GetEntry(i);
+		content += Form("%d\t%d\t%d\n", run, lumi, event);
+	}
+
+	tree -> ResetBranchAddresses();
+
+	return content;
+
+}
+
+
 //____________________________________________________________________________
 std::vector<std::vector<TString> > OtherInput::ReadMatrixFromListFile(std::string file_path, TString delimiter, int number_of_columns){
 	/*
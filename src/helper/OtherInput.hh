@@ -15,6 +15,7 @@
 
 #include <TROOT.h>
 #include <TString.h>
+#include <TDirectory.h>
 #include <TFile.h>
 #include <TTree.h>
 #include <TH1.h>
@@ -24,6 +25,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <iostream>
+#include <map>
 #include <fstream>
 #include <vector>
 #include <string>
@@ -35,7 +37,9 @@
 namespace OtherInput {
 
 	std::vector<TString> ReadColumnFromListFile(std::string, int = 0);
+	std::map<AKROSD, int> ReadCountsFromRootFile(TDirectory *, TString);
 	TString ReadFromTextFile(std::string);
+	TString ReadListFromRootFile(TDirectory *, TString);
 	std::vector<std::vector<TString> > ReadMatrixFromListFile(std::string, TString = "\t", int = 0);
 	TH1F * ReadTH1FFromROOTFile(TString, TString, TString);
 	TH2F * ReadTH2FFromROOTFile(TString, TString, TString);
@@ -16,20 +16,216 @@
 
 
 //____________________________________________________________________________
-bool OtherOutput::CloseTreeAndWrite(){
+bool OtherOutput::CloseRootFile(TFile * root_file){
+	/*
+	closes a ROOT file that has been opened to write and frees its memory
+	parameters: root_file
+	return: true (if closed successfully), false (else)
+	*/
+
+	if(root_file == 0) return false;
+
+	root_file -> Close();
+	delete root_file;
+
+	return true;
+
+}
+
+
+//____________________________________________________________________________
+bool OtherOutput::CloseTreeAndWrite(TTree * tree){
+	/*
+	writes a tree opened by OpenTreeToWrite and closes its ROOT file, which also
+	frees the memory of the tree
+	parameters: tree
+	return: true (if written and closed successfully), false (else)
+	*/
+
+	if(tree == 0 || tree -> GetCurrentFile() == 0) return false;
+
+	TFile * root_file = tree -> GetCurrentFile();
+	root_file -> cd();
+	bool success = tree -> Write("", TObject::kOverwrite) > 0;
+
+	return CloseRootFile(root_file) && success;
+
+}
+
+
+//____________________________________________________________________________
+int OtherOutput::ExportDirectory(TDirectory * directory, TString output_folder, std::vector<TString> formats, TCanvas * canvas){
+	/*
+	exports every object in a directory of a ROOT file and its subdirectories to
+	single files in the output folder; histograms are drawn and saved in all given
+	formats under their name, counters (TH1I) and event lists (TTree) are written
+	as text files under their title if the format txt is given
+	parameters: directory, output_folder, formats (file extensions, e.g. png), 
+	            canvas (the canvas to draw on)
+	return: number of exported objects
+	*/
+
+	int number_of_exported = 0;
+	bool export_text = Tools::FindElementInVector(formats, (TString) "txt");
+
+	TIter next(directory -> GetListOfKeys());
+	TKey * key;
+
+	while((key = (TKey *) next())){
+
+		TObject * object = key -> ReadObj();
+
+		if(object -> InheritsFrom("TDirectory")){
+			number_of_exported += ExportDirectory((TDirectory *) object, output_folder, formats, canvas);
+			continue;
+		}
+
+		if(object -> InheritsFrom("TH1I")){
+			if(export_text){
+				TH1I * counter = (TH1I *) object;
+				std::map<AKROSD, int> counts;
+				for(int i = 1; i <= counter -> GetNbinsX(); ++i)
+					if(TString(counter -> GetXaxis() -> GetBinLabel(i)) != "") 
+						counts[counter -> GetXaxis() -> GetBinLabel(i)] = (int) counter -> GetBinContent(i);
+				WriteToTextFile(output_folder, object -> GetTitle(), Tools::PrintContentsOfMap(counts));
+				++number_of_exported;
+			}
+		}
+
+		else if(object -> InheritsFrom("TTree")){
+			if(export_text){
+				TTree * tree = (TTree *) object;
+				int run, lumi, event;
+				tree -> SetBranchAddress("Run"  , &run  );
+				tree -> SetBranchAddress("Lumi" , &lumi );
+				tree -> SetBranchAddress("Event", &event);
+				std::string content = "";
+				for(Long64_t i = 0; i < tree -> GetEntries(); ++i){
+					tree -> GetEntry(i);
+					content += Form("%d\t%d\t%d\n", run, lumi, event);
+				}
+				WriteToTextFile(output_folder, object -> GetTitle(), Tools::ConvertStdStringToTString(content));
+				++number_of_exported;
+			}
+		}
+
+		else if(object -> InheritsFrom("TH1")){
+			std::string file_path = Tools::ConvertTStringToStdString(output_folder) + key -> GetName() + ".";
+			canvas -> cd();
+			((TH1 *) object) -> Draw();
+			for(int i = 0; i < formats.size(); ++i)
+				if(formats[i] != "txt") canvas -> SaveAs(Tools::ConvertStdStringToCString(file_path + Tools::ConvertTStringToStdString(formats[i])));
+			++number_of_exported;
+		}
+
+		delete object;
+	}
+
+	return number_of_exported;
+
+}
+
+
+//____________________________________________________________________________
+int OtherOutput::ExportRootFile(TString file_path, TString output_folder, std::vector<TString> formats){
+	/*
+	exports all histograms, counters and event lists of a module ROOT file to 
+	single files in the output folder, i.e. produces images on demand
+	parameters: file_path, output_folder, formats (file extensions, e.g. png)
+	return: number of exported objects, -1 (if the file could not be opened)
+	*/
+
+	TFile * root_file = TFile::Open(file_path, "READ");
+	if(root_file == 0 || root_file -> IsZombie()) return -1;
+
+	gROOT -> SetBatch(kTRUE);
+	TCanvas * canvas = new TCanvas("export", "C", 975, 600);
+
+	int number_of_exported = ExportDirectory(root_file, output_folder, formats, canvas);
+
+	delete canvas;
+	root_file -> Close();
+	delete root_file;
+
+	return number_of_exported;
 
 }
 
 
 //____________________________________________________________________________
-bool OtherOutput::OpenTreeToWrite(TString configplot, int module, TString output_name){
+TDirectory * OtherOutput::GetRootDirectory(TFile * root_file, TString path){
+	/*
+	returns a directory in a ROOT file, the directory and all its parents are 
+	created if they do not exist yet
+	parameters: root_file, path (directories separated by /)
+	return: directory, 0 (if it could not be created)
+	*/
 
-	//TFile * root_file = new TFile(root_file_path);
-	//if(root_file.IsZombie()) return root_file;
-	//
-	//
-	//f.IsZombie()
+	if(root_file == 0) return 0;
 
+	TDirectory * directory = root_file;
+	std::vector<TString> names = Tools::ExplodeTString(path, "/");
+
+	for(int i = 0; i < names.size(); ++i){
+		if(names[i] == "") continue;
+		TDirectory * subdirectory = directory -> GetDirectory(names[i]);
+		if(subdirectory == 0) subdirectory = directory -> mkdir(names[i]);
+		if(subdirectory == 0) return 0;
+		directory = subdirectory;
+	}
+
+	return directory;
+
+}
+
+
+//____________________________________________________________________________
+TFile * OtherOutput::OpenRootFileToWrite(TString output_folder, TString file_name){
+	/*
+	opens (and overwrites) a ROOT file to write
+	parameters: output_folder, file_name (without extension)
+	return: root_file, 0 (if it could not be opened)
+	*/
+
+	std::string file_path = Tools::ConvertTStringToStdString(output_folder) + Tools::ConvertTStringToStdString(file_name) + ".root";
+
+	TFile * root_file = new TFile(Tools::ConvertStdStringToCString(file_path), "RECREATE");
+	if(root_file -> IsZombie()) {
+		delete root_file;
+		return 0;
+	}
+
+	return root_file;
+
+}
+
+
+//____________________________________________________________________________
+TTree * OtherOutput::OpenTreeToWrite(TString output_folder, TString file_name, TTree * input_tree, std::vector<TString> branches, int compression){
+	/*
+	opens (and overwrites) a ROOT file and creates an empty copy of a tree in it
+	that only has the given branches; the copy shares the branch addresses with
+	the tree, i.e. every Fill writes the entry that is currently loaded
+	parameters: output_folder, file_name (without extension), input_tree, branches
+	            (names, wildcards allowed), compression (algorithm * 100 + level)
+	return: tree, 0 (if the file could not be opened)
+	*/
+
+	if(input_tree == 0) return 0;
+
+	TFile * root_file = OpenRootFileToWrite(output_folder, file_name);
+	if(root_file == 0) return 0;
+
+	root_file -> SetCompressionSettings(compression);
+	root_file -> cd();
+
+	SetActiveBranches(input_tree, branches);
+	TTree * tree = input_tree -> CloneTree(0);
+	input_tree -> SetBranchStatus("*", 1);
+
+	if(tree == 0) CloseRootFile(root_file);
+
+	return tree;
 
 }
 
@@ -41,6 +237,83 @@ void OtherOutput::PrintUsage(){
 }
 
 
+//____________________________________________________________________________
+void OtherOutput::SetActiveBranches(TTree * tree, std::vector<TString> branches){
+	/*
+	activates only the given branches of a tree, the copies of the tree then
+	only get these branches
+	parameters: tree, branches (names, wildcards allowed)
+	return: none
+	*/
+
+	tree -> SetBranchStatus("*", 0);
+	for(int i = 0; i < branches.size(); ++i)
+		tree -> SetBranchStatus(branches[i], 1);
+
+}
+
+
+//____________________________________________________________________________
+bool OtherOutput::WriteCountsToRootFile(TDirectory * directory, TString name, TString title, std::map<AKROSD, int> counts){
+	/*
+	writes counts to a directory of a ROOT file as a single TH1I, every count is
+	one bin labeled by its key
+	parameters: directory, name, title (file name used when exporting), counts
+	return: true (if written successfully), false (else)
+	*/
+
+	if(directory == 0) return false;
+
+	TH1I * counter = new TH1I(name, title, counts.size() > 0 ? counts.size() : 1, 0, counts.size() > 0 ? counts.size() : 1);
+	counter -> SetDirectory(0);
+
+	int bin = 1;
+	for(std::map<AKROSD, int>::iterator i = counts.begin(); i != counts.end(); ++i, ++bin){
+		counter -> GetXaxis() -> SetBinLabel(bin, i -> first);
+		counter -> SetBinContent(bin, i -> second);
+	}
+
+	directory -> WriteTObject(counter, name);
+	delete counter;
+
+	return true;
+
+}
+
+
+//____________________________________________________________________________
+bool OtherOutput::WriteListToRootFile(TDirectory * directory, TString name, TString title, TString content){
+	/*
+	writes an event list to a directory of a ROOT file as a TTree with the
+	branches Run, Lumi and Event
+	parameters: directory, name, title (file name used when exporting), content
+	            (one event per line, Run, Lumi and Event separated by tabs)
+	return: true (if written successfully), false (else)
+	*/
+
+	if(directory == 0) return false;
+
+	int run, lumi, event;
+
+	directory -> cd();
+	TTree * tree = new TTree(name, title);
+	tree -> Branch("Run"  , &run  , "Run/I"  );
+	tree -> Branch("Lumi" , &lumi , "Lumi/I" );
+	tree -> Branch("Event", &event, "Event/I");
+
+	std::istringstream stream(Tools::ConvertTStringToStdString(content));
+	std::string line;
+	while(std::getline(stream, line))
+		if(sscanf(line.c_str(), "%d\t%d\t%d", &run, &lumi, &event) == 3) tree -> Fill();
+
+	directory -> WriteTObject(tree, name);
+	delete tree;
+
+	return true;
+
+}
+
+
 //____________________________________________________________________________
 bool OtherOutput::WriteToTextFile(TString output_folder, TString file_name, TString content){
 
@@ -54,6 +327,40 @@ bool OtherOutput::WriteToTextFile(TString output_folder, TString file_name, TStr
 }
 
 
+//____________________________________________________________________________
+bool OtherOutput::WriteTreeCopy(TString output_folder, TString file_name, TTree * input_tree, Long64_t entries, std::vector<TString> branches, int compression){
+	/*
+	copies the first entries of a tree with the given branches into a new ROOT
+	file; if all entries are copied, the baskets are copied without unzipping
+	them (fast cloning), such that they keep the compression of the input
+	parameters: output_folder, file_name (without extension), input_tree, entries,
+	            branches (names, wildcards allowed), compression (algorithm * 100
+	            + level, used for the baskets that are not copied as they are)
+	return: true (if written successfully), false (else)
+	*/
+
+	if(input_tree == 0) return false;
+
+	TFile * root_file = OpenRootFileToWrite(output_folder, file_name);
+	if(root_file == 0) return false;
+
+	root_file -> SetCompressionSettings(compression);
+	root_file -> cd();
+
+	SetActiveBranches(input_tree, branches);
+	TTree * tree = input_tree -> CloneTree(entries < input_tree -> GetEntries() ? entries : -1, "fast");
+	input_tree -> SetBranchStatus("*", 1);
+
+	if(tree == 0) {
+		CloseRootFile(root_file);
+		return false;
+	}
+
+	return CloseTreeAndWrite(tree);
+
+}
+
+
 
 
 
@@ -18,17 +18,38 @@
 #include "TFile.h"
 #include "TDirectory.h"
 #include "TTree.h"
-
+#include "TCanvas.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TKey.h"
+#include "TList.h"
+
+#include <stdio.h>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "src/helper/CustomTypes.hh"
 #include "src/helper/Tools.hh"
 
 
 
 namespace OtherOutput{
 
-	bool CloseTreeAndWrite();
-	bool OpenTreeToWrite(TString, int, TString);
+	bool CloseRootFile(TFile *);
+	bool CloseTreeAndWrite(TTree *);
+	int ExportDirectory(TDirectory *, TString, std::vector<TString>, TCanvas *);
+	int ExportRootFile(TString, TString, std::vector<TString>);
+	TDirectory * GetRootDirectory(TFile *, TString);
+	TFile * OpenRootFileToWrite(TString, TString);
+	TTree * OpenTreeToWrite(TString, TString, TTree *, std::vector<TString>, int);
 	void PrintUsage();
+	void SetActiveBranches(TTree *, std::vector<TString>);
+	bool WriteCountsToRootFile(TDirectory *, TString, TString, std::map<AKROSD, int>);
+	bool WriteListToRootFile(TDirectory *, TString, TString, TString);
 	bool WriteToTextFile(TString, TString, TString);
+	bool WriteTreeCopy(TString, TString, TTree *, Long64_t, std::vector<TString>, int);
 	
 }
 
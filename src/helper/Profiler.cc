@@ -0,0 +1,272 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/Profiler.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CLASS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+Profiler::Profiler(){
+	/*
+	constructs the Profiler class, which attributes the time spent parsing
+	AKROSD strings to the single definitions and their clauses
+	parameters: none
+	return: none
+	*/
+
+	Initialize();
+
+}
+
+
+//____________________________________________________________________________
+Profiler::~Profiler(){
+	/*
+	destructs the Profiler class
+	parameters: none
+	return: none
+	*/
+
+}
+
+
+//____________________________________________________________________________
+void Profiler::Initialize(){
+	/*
+	initializes the Profiler class, it is inactive by default
+	parameters: none
+	return: none
+	*/
+
+	kActive = false;
+	Clear();
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR SETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void Profiler::AddDefinitions(Label type, std::map<Label, AKROSD> definitions){
+	/*
+	adds the definitions of a type (o, d or e) such that their names can be
+	found from the AKROSD string, which is all the parser gets to see
+	parameters: type, definitions
+	return: none
+	*/
+
+	for(std::map<Label, AKROSD>::iterator i = definitions.begin(); i != definitions.end(); ++i)
+		kDefinitionKeys[type + " " + i -> second] = type + " " + i -> first;
+
+}
+
+
+//____________________________________________________________________________
+void Profiler::SetActive(bool new_value){
+	/*
+	activates or deactivates the profiler
+	parameters: new_value
+	return: none
+	*/
+
+	kActive = new_value;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR READING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+TString Profiler::GetKey(Label type, AKROSD definition){
+	/*
+	returns the key of a definition, i.e. its type and name; strings that are no
+	definition of the configuration are given by themselves
+	parameters: type, definition
+	return: key
+	*/
+
+	std::map<TString, TString>::iterator key = kDefinitionKeys.find(type + " " + definition);
+	if(key != kDefinitionKeys.end()) return key -> second;
+
+	return type + " " + definition;
+
+}
+
+
+//____________________________________________________________________________
+bool Profiler::IsActive(){
+	/*
+	returns if the profiler is active
+	parameters: none
+	return: kActive
+	*/
+
+	return kActive;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR PROFILING                                              **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void Profiler::Clear(){
+	/*
+	clears all measurements, e.g. at the beginning of a module
+	parameters: none
+	return: none
+	*/
+
+	kRecords.clear();
+	kStack.clear();
+
+}
+
+
+//____________________________________________________________________________
+TString Profiler::PrintReport(){
+	/*
+	prints all definitions and clauses ranked by their exclusive time, i.e. the
+	time spent in them but not in nested definitions or clauses; the inclusive
+	time contains the nested ones, a clause is given as "definition : clause"
+	parameters: none
+	return: report
+	*/
+
+	std::vector<std::pair<double, TString> > ranking;
+	double total = 0.;
+
+	for(std::map<TString, ProfilerRecord>::iterator i = kRecords.begin(); i != kRecords.end(); ++i){
+		ranking.push_back(std::make_pair(i -> second.exclusive, i -> first));
+		total += i -> second.exclusive;
+	}
+
+	std::sort(ranking.rbegin(), ranking.rend());
+
+	TString report = "#rank\tcalls\tinclusive_s\texclusive_s\texclusive_%\tmean_inclusive_us\tkey\n";
+
+	for(int i = 0; i < ranking.size(); ++i){
+		ProfilerRecord & record = kRecords[ranking[i].second];
+		report += Form("%d\t%ld\t%.6f\t%.6f\t%.2f\t%.3f\t%s\n", i + 1, record.calls, record.inclusive, record.exclusive,
+		               (total > 0.) ? 100. * record.exclusive / total : 0., 1.e6 * record.inclusive / record.calls,
+		               ranking[i].second.Data());
+	}
+
+	return report;
+
+}
+
+
+//____________________________________________________________________________
+void Profiler::Start(TString key, TString owner){
+	/*
+	starts measuring a definition or clause
+	parameters: key, owner (the definition the measured part belongs to)
+	return: none
+	*/
+
+	ProfilerFrame frame;
+	frame.key      = key;
+	frame.owner    = owner;
+	frame.children = 0.;
+	frame.start    = Verbose::GetTime();
+
+	kStack.push_back(frame);
+
+}
+
+
+//____________________________________________________________________________
+void Profiler::StartClause(AKROSD statement){
+	/*
+	starts measuring a clause (regular statement), which belongs to the
+	innermost definition being measured
+	parameters: statement
+	return: none
+	*/
+
+	if(!kActive) return;
+
+	TString owner = (kStack.size() > 0) ? kStack.back().owner : "";
+	Start(owner + " : " + statement, owner);
+
+}
+
+
+//____________________________________________________________________________
+void Profiler::StartDefinition(Label type, AKROSD definition, Label name){
+	/*
+	starts measuring a definition of a given type (o, d or e); if the name is not
+	given, it is looked up from the AKROSD string
+	parameters: type, definition, name
+	return: none
+	*/
+
+	if(!kActive) return;
+
+	TString key = (name != "") ? type + " " + name : GetKey(type, definition);
+	Start(key, key);
+
+}
+
+
+//____________________________________________________________________________
+void Profiler::Stop(){
+	/*
+	stops measuring the innermost definition or clause and adds its time to the
+	records; every StartClause and StartDefinition needs one Stop
+	parameters: none
+	return: none
+	*/
+
+	if(!kActive || kStack.size() == 0) return;
+
+	double inclusive = Verbose::GetTime() - kStack.back().start;
+
+	ProfilerRecord & record = kRecords[kStack.back().key];
+	record.calls     += 1;
+	record.inclusive += inclusive;
+	record.exclusive += inclusive - kStack.back().children;
+
+	kStack.pop_back();
+	if(kStack.size() > 0) kStack.back().children += inclusive;
+
+}
@@ -0,0 +1,65 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef PROFILER_HH
+#define PROFILER_HH
+
+#include "TROOT.h"
+#include "TString.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "src/helper/CustomTypes.hh"
+#include "src/helper/Tools.hh"
+#include "src/helper/Verbose.hh"
+
+
+
+class Profiler{
+
+public:
+
+	// Member Functions
+
+	Profiler();
+	~Profiler();
+	void Initialize();
+
+	void AddDefinitions(Label, std::map<Label, AKROSD>);
+	void SetActive(bool);
+
+	bool IsActive();
+	TString GetKey(Label, AKROSD);
+
+	void Clear();
+	TString PrintReport();
+	void StartClause(AKROSD);
+	void StartDefinition(Label, AKROSD, Label = "");
+	void Stop();
+
+
+private:
+
+	void Start(TString, TString);
+
+	bool kActive;
+	std::map<TString, TString> kDefinitionKeys;
+	std::map<TString, ProfilerRecord> kRecords;
+	std::vector<ProfilerFrame> kStack;
+
+};
+
+
+#endif
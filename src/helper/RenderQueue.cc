@@ -0,0 +1,298 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/RenderQueue.hh"
+
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CLASS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+RenderQueue::RenderQueue(Verbose * verbosity, std::vector<TString> formats, int number_of_workers){
+	/*
+	constructs the RenderQueue class
+	parameters: verbosity, formats (file extensions, e.g. png), number_of_workers
+	return: none
+	*/
+
+	kVerbose = verbosity;
+	kVerbose -> Class("RenderQueue");
+	Initialize(formats, number_of_workers);
+
+}
+
+
+//____________________________________________________________________________
+RenderQueue::~RenderQueue(){
+	/*
+	destructs the RenderQueue class, waits for all workers to finish
+	paramters: none
+	return: none
+	*/
+
+	Wait();
+
+}
+
+
+//____________________________________________________________________________
+void RenderQueue::Initialize(std::vector<TString> formats, int number_of_workers){
+	/*
+	initializes the RenderQueue class
+	paramters: formats (file extensions, e.g. png), number_of_workers
+	return: none
+	*/
+
+	kCanvas = 0;
+	kFormats = formats;
+	kNumberOfWorkers = number_of_workers;
+
+}
+
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR SETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void RenderQueue::SetFormats(std::vector<TString> new_value){
+	/*
+	sets the file formats (extensions) every plot is written in
+	parameters: new_value
+	return: none
+	*/
+
+	kFormats = new_value;
+
+}
+
+
+//____________________________________________________________________________
+void RenderQueue::SetNumberOfWorkers(int new_value){
+	/*
+	sets the number of worker processes, 0 renders in the main process
+	parameters: new_value
+	return: none
+	*/
+
+	kNumberOfWorkers = new_value;
+
+}
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR READING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+std::vector<TString> RenderQueue::GetFormats(){
+	/*
+	returns the file formats every plot is written in
+	parameters: none
+	return: kFormats
+	*/
+
+	return kFormats;
+
+}
+
+
+//____________________________________________________________________________
+int RenderQueue::GetNumberOfQueued(){
+	/*
+	returns the number of histograms waiting to be rendered
+	parameters: none
+	return: number of queued histograms
+	*/
+
+	return kH1Ds.size() + kH2Ds.size();
+
+}
+
+
+//____________________________________________________________________________
+int RenderQueue::GetNumberOfWorkers(){
+	/*
+	returns the number of worker processes
+	parameters: none
+	return: kNumberOfWorkers
+	*/
+
+	return kNumberOfWorkers;
+
+}
+
+
+//____________________________________________________________________________
+bool RenderQueue::IsFormat(TString format){
+	/*
+	checks if a file format can be written by the render queue
+	parameters: format (file extension)
+	return: true (if it can be written), false (else)
+	*/
+
+	return format == "png" || format == "pdf" || format == "eps" || format == "svg" || format == "root" || format == "C";
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RENDERING                                              **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void RenderQueue::Add(H1D * histogram){
+	/*
+	queues a filled 1d histogram for rendering
+	parameters: histogram
+	return: none
+	*/
+
+	kH1Ds.push_back(histogram);
+
+}
+
+
+//____________________________________________________________________________
+void RenderQueue::Add(H2D * histogram){
+	/*
+	queues a filled 2d histogram for rendering
+	parameters: histogram
+	return: none
+	*/
+
+	kH2Ds.push_back(histogram);
+
+}
+
+
+//____________________________________________________________________________
+bool RenderQueue::Flush(){
+	/*
+	waits for the workers of the previous flush, then forks the workers that
+	render all queued histograms and returns immediately; every worker works on
+	its own copy of the histograms, so the caller may go on filling new ones
+	parameters: none
+	return: true (if the previous flush and all fallbacks succeeded), false (else)
+	*/
+
+	bool success = Wait();
+
+	int number_of_queued = GetNumberOfQueued();
+	if(number_of_queued == 0) return success;
+
+	int number_of_workers = kNumberOfWorkers;
+	if(number_of_workers > number_of_queued) number_of_workers = number_of_queued;
+
+	if(number_of_workers < 1) {
+		success = Render(0, 1) && success;
+		kH1Ds.clear();
+		kH2Ds.clear();
+		return success;
+	}
+
+	// buffered output would otherwise be printed once more by every worker
+	std::cout.flush();
+	std::cerr.flush();
+	fflush(0);
+
+	for(int i = 0; i < number_of_workers; ++i){
+		pid_t pid = fork();
+
+		if(pid == 0) {
+			gROOT -> SetBatch(kTRUE);
+			kCanvas = 0;
+			_exit(Render(i, number_of_workers) ? 0 : 1);
+		}
+
+		if(pid < 0) success = Render(i, number_of_workers) && success;
+		else        kWorkers.push_back(pid);
+	}
+
+	kH1Ds.clear();
+	kH2Ds.clear();
+
+	return success;
+
+}
+
+
+//____________________________________________________________________________
+bool RenderQueue::Render(int worker, int number_of_workers){
+	/*
+	renders every number_of_workers-th queued histogram, starting at worker,
+	on a canvas that belongs to this process only
+	parameters: worker (index of the worker), number_of_workers
+	return: true (if all plots were written), false (else)
+	*/
+
+	if(kCanvas == 0)
+		kCanvas = new TCanvas(Tools::ConvertStdStringToCString("render_" + Tools::ConvertIntToStdString(worker)), "C", 975, 600);
+
+	bool success = true;
+
+	for(int i = worker; i < kH1Ds.size() + kH2Ds.size(); i += number_of_workers){
+		if(i < kH1Ds.size()) success = kH1Ds[i] -> Write(kCanvas, kFormats) && success;
+		else                 success = kH2Ds[i - kH1Ds.size()] -> Write(kCanvas, kFormats) && success;
+	}
+
+	return success;
+
+}
+
+
+//____________________________________________________________________________
+bool RenderQueue::Wait(){
+	/*
+	waits for all workers to finish
+	parameters: none
+	return: true (if all workers succeeded), false (else)
+	*/
+
+	bool success = true;
+
+	for(int i = 0; i < kWorkers.size(); ++i){
+		int status = 0;
+		if(waitpid(kWorkers[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			success = false;
+	}
+
+	kWorkers.clear();
+
+	return success;
+
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef RENDERQUEUE_HH
+#define RENDERQUEUE_HH
+
+#include "TCanvas.h"
+#include "TROOT.h"
+#include "TString.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <iostream>
+#include <vector>
+
+#include "src/helper/H1D.hh"
+#include "src/helper/H2D.hh"
+#include "src/helper/Tools.hh"
+#include "src/helper/Verbose.hh"
+
+
+
+class RenderQueue{
+
+public:
+
+	// Member Functions
+
+	RenderQueue(Verbose *, std::vector<TString>, int = 4);
+	virtual ~RenderQueue();
+	virtual void Initialize(std::vector<TString>, int);
+
+	void SetFormats(std::vector<TString>);
+	void SetNumberOfWorkers(int);
+
+	std::vector<TString> GetFormats();
+	int GetNumberOfQueued();
+	int GetNumberOfWorkers();
+	static bool IsFormat(TString);
+
+	void Add(H1D *);
+	void Add(H2D *);
+	bool Flush();
+	bool Wait();
+
+
+private:
+
+	bool Render(int, int);
+
+	TCanvas * kCanvas;
+	std::vector<TString> kFormats;
+	std::vector<H1D*> kH1Ds;
+	std::vector<H2D*> kH2Ds;
+	int kNumberOfWorkers;
+	Verbose * kVerbose;
+	std::vector<pid_t> kWorkers;
+
+};
+
+
+#endif
@@ -0,0 +1,473 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/SelectionBitmap.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CLASS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+SelectionBitmap::SelectionBitmap(){
+	/*
+	constructs the SelectionBitmap class, which keeps one bit per event
+	selection and object multiplicity for every entry of a sample; the bits are
+	written in the order of the entries of the sample, such that entry i of the
+	bitmap is entry i of the sample, and can be queried without the sample
+	parameters: none
+	return: none
+	*/
+
+	kPath          = "";
+	kTemporaryPath = "";
+	kEntries       = 0;
+	kFile          = 0;
+	kTree          = 0;
+
+}
+
+
+//____________________________________________________________________________
+SelectionBitmap::~SelectionBitmap(){
+	/*
+	destructs the SelectionBitmap class, a bitmap that is still written is
+	closed
+	parameters: none
+	return: none
+	*/
+
+	Close();
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR WRITING THE BITMAP                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+bool SelectionBitmap::Close(){
+	/*
+	writes and closes the bitmap; it is written to a temporary file first and
+	only moved to its place if it has a bitmap for every entry of the sample
+	parameters: none
+	return: true (if the bitmap is complete and written), false (else)
+	*/
+
+	if(kTree == 0) return true;
+
+	TDirectory * directory = gDirectory;
+
+	bool complete = kTree -> GetEntries() == kEntries;
+
+	kFile -> cd();
+	kTree -> Write("", TObject::kOverwrite);
+	kFile -> Close();
+	delete kFile;
+
+	kFile = 0;
+	kTree = 0;
+
+	if(directory != 0) directory -> cd();
+
+	std::string temporary_path = Tools::ConvertTStringToStdString(kTemporaryPath);
+	if(complete && FileOperations::MoveFile(temporary_path, Tools::ConvertTStringToStdString(kPath))) return true;
+
+	FileOperations::RemoveFile(temporary_path);
+	return false;
+
+}
+
+
+//____________________________________________________________________________
+void SelectionBitmap::Fill(){
+	/*
+	appends the bits of the current entry and clears them for the next one
+	parameters: none
+	return: none
+	*/
+
+	if(kTree == 0) return;
+
+	kTree -> Fill();
+	std::fill(kWords.begin(), kWords.end(), 0);
+
+}
+
+
+//____________________________________________________________________________
+bool SelectionBitmap::Open(TString path, std::vector<Label> labels, Long64_t entries){
+	/*
+	opens a bitmap to write, with one bit per label; the labels are kept in the
+	title of the tree and the bits in words of 32, which the compression of the
+	file reduces to little more than the selected entries
+	parameters: path, labels, entries (of the sample)
+	return: true (if opened), false (else)
+	*/
+
+	Close();
+
+	if(labels.size() == 0) return false;
+
+	kPath          = path;
+	kTemporaryPath = path + Form(".%d.tmp", (int) getpid());
+	kEntries       = entries;
+	kLabels        = labels;
+	kWords.assign((labels.size() + 31) / 32, 0);
+
+	TString title = "";
+	for(int i = 0; i < labels.size(); ++i)
+		title += (i == 0 ? "" : ";") + labels[i];
+
+	TDirectory * directory = gDirectory;
+
+	kFile = new TFile(kTemporaryPath, "RECREATE");
+	if(kFile -> IsZombie()) {
+		delete kFile;
+		kFile = 0;
+	}
+	else {
+		kTree = new TTree("Bitmaps", title);
+		kTree -> Branch("bits", &kWords[0], Form("bits[%d]/i", (int) kWords.size()));
+	}
+
+	if(directory != 0) directory -> cd();
+
+	return kTree != 0;
+
+}
+
+
+//____________________________________________________________________________
+void SelectionBitmap::SetBit(int bit, bool value){
+	/*
+	sets the bit of a label for the current entry
+	parameters: bit (index of the label), value
+	return: none
+	*/
+
+	if(value) kWords[bit / 32] |=  (1u << (bit % 32));
+	else      kWords[bit / 32] &= ~(1u << (bit % 32));
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR READING AND QUERYING THE BITMAP                        **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+bool SelectionBitmap::Read(TString path){
+	/*
+	reads a bitmap written before; the bits are turned into one column per
+	label with 64 entries per word, such that a query combines whole words
+	parameters: path
+	return: true (if read), false (else)
+	*/
+
+	Close();
+
+	kLabels .clear();
+	kColumns.clear();
+	kEntries = 0;
+
+	TDirectory * directory = gDirectory;
+
+	TFile * file = TFile::Open(path);
+	if(file == 0 || file -> IsZombie()) {
+		if(file != 0) delete file;
+		if(directory != 0) directory -> cd();
+		return false;
+	}
+
+	TTree * tree = (TTree *) file -> Get("Bitmaps");
+	if(tree == 0) {
+		file -> Close();
+		delete file;
+		if(directory != 0) directory -> cd();
+		return false;
+	}
+
+	kLabels  = Tools::ExplodeTString(tree -> GetTitle(), ";");
+	kEntries = tree -> GetEntries();
+	kColumns.assign(kLabels.size(), std::vector<ULong64_t>((kEntries + 63) / 64, 0));
+
+	std::vector<UInt_t> words((kLabels.size() + 31) / 32, 0);
+	tree -> SetBranchAddress("bits", &words[0]);
+
+	for(Long64_t i = 0; i < kEntries; ++i){
+		tree -> GetEntry(i);
+		for(int w = 0; w < words.size(); ++w){
+			for(UInt_t word = words[w]; word != 0; word &= word - 1){
+				int bit = 0;
+				while(!(word & (1u << bit))) ++bit;
+				kColumns[w * 32 + bit][i / 64] |= (1ULL << (i % 64));
+			}
+		}
+	}
+
+	file -> Close();
+	delete file;
+
+	if(directory != 0) directory -> cd();
+
+	return true;
+
+}
+
+
+//____________________________________________________________________________
+bool SelectionBitmap::Query(TString expression, std::vector<ULong64_t> & result){
+	/*
+	evaluates a combination of labels for all entries at once, in the syntax of
+	the AKROSD strings: a comma is an and, | is an or, ! negates and brackets
+	group, e.g. SR05,BR02 or (SR01|SR02),!#LM=0
+	parameters: expression, result (one bit per entry, 64 entries per word)
+	return: true (if the expression is legal), false (else)
+	*/
+
+	expression.ReplaceAll(" ", "");
+
+	Ssiz_t position = 0;
+	if(!ParseOr(expression, position, result)) return false;
+
+	return position == expression.Length();
+
+}
+
+
+//____________________________________________________________________________
+bool SelectionBitmap::ParseAnd(TString & expression, Ssiz_t & position, std::vector<ULong64_t> & result){
+	/*
+	parses terms connected by commas
+	parameters: expression, position (first character, moved behind the
+	            terms), result
+	return: true (if legal), false (else)
+	*/
+
+	if(!ParseUnary(expression, position, result)) return false;
+
+	std::vector<ULong64_t> term;
+
+	while(position < expression.Length() && expression[position] == ','){
+		++position;
+		if(!ParseUnary(expression, position, term)) return false;
+		for(int w = 0; w < result.size(); ++w)
+			result[w] &= term[w];
+	}
+
+	return true;
+
+}
+
+
+//____________________________________________________________________________
+bool SelectionBitmap::ParseOr(TString & expression, Ssiz_t & position, std::vector<ULong64_t> & result){
+	/*
+	parses terms connected by |, the comma binds stronger
+	parameters: expression, position (first character, moved behind the
+	            terms), result
+	return: true (if legal), false (else)
+	*/
+
+	if(!ParseAnd(expression, position, result)) return false;
+
+	std::vector<ULong64_t> term;
+
+	while(position < expression.Length() && expression[position] == '|'){
+		++position;
+		if(!ParseAnd(expression, position, term)) return false;
+		for(int w = 0; w < result.size(); ++w)
+			result[w] |= term[w];
+	}
+
+	return true;
+
+}
+
+
+//____________________________________________________________________________
+bool SelectionBitmap::ParseUnary(TString & expression, Ssiz_t & position, std::vector<ULong64_t> & result){
+	/*
+	parses a negated term, a term in brackets or a label
+	parameters: expression, position (first character, moved behind the term),
+	            result
+	return: true (if legal), false (else)
+	*/
+
+	if(position >= expression.Length()) return false;
+
+
+	// negation, the entries behind the last one stay empty
+
+	if(expression[position] == '!'){
+		++position;
+		if(!ParseUnary(expression, position, result)) return false;
+		for(int w = 0; w < result.size(); ++w)
+			result[w] = ~result[w];
+		if(kEntries % 64 != 0) result.back() &= (1ULL << (kEntries % 64)) - 1;
+		return true;
+	}
+
+
+	// brackets
+
+	if(expression[position] == '('){
+		++position;
+		if(!ParseOr(expression, position, result)) return false;
+		if(position >= expression.Length() || expression[position] != ')') return false;
+		++position;
+		return true;
+	}
+
+
+	// label
+
+	Ssiz_t start = position;
+	while(position < expression.Length() && TString(",|!()").First(expression[position]) == kNPOS) ++position;
+
+	Label label = expression(start, position - start);
+
+	for(int i = 0; i < kLabels.size(); ++i){
+		if(kLabels[i] != label) continue;
+		result = kColumns[i];
+		return true;
+	}
+
+	return false;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR GETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+Long64_t SelectionBitmap::CountEntries(const std::vector<ULong64_t> & result){
+	/*
+	returns the number of entries of a query result
+	parameters: result
+	return: number of entries
+	*/
+
+	Long64_t count = 0;
+
+	for(int w = 0; w < result.size(); ++w)
+		for(ULong64_t word = result[w]; word != 0; word &= word - 1)
+			++count;
+
+	return count;
+
+}
+
+
+//____________________________________________________________________________
+std::vector<Long64_t> SelectionBitmap::GetEntries(const std::vector<ULong64_t> & result){
+	/*
+	returns the entry numbers of a query result, they are the entry numbers of
+	the sample
+	parameters: result
+	return: entries
+	*/
+
+	std::vector<Long64_t> entries;
+
+	for(int w = 0; w < result.size(); ++w)
+		for(int bit = 0; bit < 64 && result[w] >> bit != 0; ++bit)
+			if(result[w] & (1ULL << bit)) entries.push_back(64 * (Long64_t) w + bit);
+
+	return entries;
+
+}
+
+
+//____________________________________________________________________________
+std::vector<Label> SelectionBitmap::GetLabels(){
+	/*
+	returns the labels of the bitmap
+	parameters: none
+	return: labels
+	*/
+
+	return kLabels;
+
+}
+
+
+//____________________________________________________________________________
+std::vector<Label> SelectionBitmap::GetLabelsOfEntry(Long64_t entry){
+	/*
+	returns the labels whose bit is set for an entry, e.g. the selections the
+	entry passes
+	parameters: entry
+	return: labels
+	*/
+
+	std::vector<Label> labels;
+
+	if(entry < 0 || entry >= kEntries) return labels;
+
+	for(int i = 0; i < kLabels.size(); ++i)
+		if(kColumns[i][entry / 64] & (1ULL << (entry % 64))) labels.push_back(kLabels[i]);
+
+	return labels;
+
+}
+
+
+//____________________________________________________________________________
+Long64_t SelectionBitmap::GetNumberOfEntries(){
+	/*
+	returns the number of entries of the bitmap
+	parameters: none
+	return: number of entries
+	*/
+
+	return kEntries;
+
+}
+
+
+//____________________________________________________________________________
+bool SelectionBitmap::IsOpen(){
+	/*
+	returns true if a bitmap is being written
+	parameters: none
+	return: true (if open), false (else)
+	*/
+
+	return kTree != 0;
+
+}
@@ -0,0 +1,75 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef SELECTIONBITMAP_HH
+#define SELECTIONBITMAP_HH
+
+#include "TROOT.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "src/helper/CustomTypes.hh"
+#include "src/helper/FileOperations.hh"
+#include "src/helper/Tools.hh"
+
+
+
+class SelectionBitmap{
+
+public:
+
+	// Member Functions
+
+	SelectionBitmap();
+	~SelectionBitmap();
+
+	bool Close();
+	void Fill();
+	bool Open(TString, std::vector<Label>, Long64_t);
+	bool Read(TString);
+	void SetBit(int, bool);
+
+	Long64_t CountEntries(const std::vector<ULong64_t> &);
+	std::vector<Long64_t> GetEntries(const std::vector<ULong64_t> &);
+	std::vector<Label> GetLabels();
+	std::vector<Label> GetLabelsOfEntry(Long64_t);
+	Long64_t GetNumberOfEntries();
+	bool IsOpen();
+	bool Query(TString, std::vector<ULong64_t> &);
+
+
+private:
+
+	bool ParseAnd(TString &, Ssiz_t &, std::vector<ULong64_t> &);
+	bool ParseOr(TString &, Ssiz_t &, std::vector<ULong64_t> &);
+	bool ParseUnary(TString &, Ssiz_t &, std::vector<ULong64_t> &);
+
+	TString kPath;
+	TString kTemporaryPath;
+	Long64_t kEntries;
+	std::vector<Label> kLabels;
+	TFile * kFile;
+	TTree * kTree;
+	std::vector<UInt_t> kWords;                    // bits of the current entry, 32 per word
+	std::vector<std::vector<ULong64_t> > kColumns; // bits of every label for all entries, 64 entries per word
+
+};
+
+
+#endif
@@ -0,0 +1,581 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/helper/SyntheticSample.hh"
+
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CLASS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+SyntheticSample::SyntheticSample(unsigned int seed){
+	/*
+	constructs the SyntheticSample class, which generates random events with
+	the branch layout of the minitrees (see Base.hh)
+	parameters: seed (seed of the random generator, same seed gives same events)
+	return: none
+	*/
+
+	Initialize(seed);
+
+}
+
+
+//____________________________________________________________________________
+SyntheticSample::~SyntheticSample(){
+	/*
+	destructs the SyntheticSample class
+	parameters: none
+	return: none
+	*/
+
+	delete kRandom;
+
+}
+
+
+//____________________________________________________________________________
+void SyntheticSample::Initialize(unsigned int seed){
+	/*
+	initializes the SyntheticSample class and allocates all vector leaves
+	parameters: seed
+	return: none
+	*/
+
+	kEventNumber   = 0;
+	kMeanElectrons = 0.5;
+	kMeanJets      = 3.0;
+	kMeanMuons     = 1.2;
+	kRandom        = new TRandom3(seed);
+
+	MuPt               = new std::vector<float>;
+	MuEta              = new std::vector<float>;
+	MuPhi              = new std::vector<float>;
+	MuCharge           = new std::vector<int>;
+	MuPFIso            = new std::vector<float>;
+	MuD0               = new std::vector<float>;
+	MuIsGlobalMuon     = new std::vector<int>;
+	MuIsPFMuon         = new std::vector<int>;
+	MuNChi2            = new std::vector<float>;
+	MuNMatchedStations = new std::vector<int>;
+	MuDz               = new std::vector<float>;
+	MuNSiLayers        = new std::vector<int>;
+	MuD0BS             = new std::vector<float>;
+	MuIso03SumPt       = new std::vector<float>;
+	MuIso03EmPt        = new std::vector<float>;
+	MuIso03HadPt       = new std::vector<float>;
+	MuIsVeto           = new std::vector<bool>;
+	MuIsLoose          = new std::vector<bool>;
+	MuIsTight          = new std::vector<bool>;
+	MuIsPrompt         = new std::vector<bool>;
+	MuID               = new std::vector<int>;
+	MuMID              = new std::vector<int>;
+	MuGMID             = new std::vector<int>;
+	ElPt               = new std::vector<float>;
+	ElEta              = new std::vector<float>;
+	ElPhi              = new std::vector<float>;
+	ElCharge           = new std::vector<int>;
+	ElPFIso            = new std::vector<float>;
+	ElD0               = new std::vector<float>;
+	ElChCo             = new std::vector<float>;
+	ElIsVeto           = new std::vector<bool>;
+	ElIsLoose          = new std::vector<bool>;
+	ElIsTight          = new std::vector<bool>;
+	ElIsPrompt         = new std::vector<bool>;
+	ElID               = new std::vector<int>;
+	ElMID              = new std::vector<int>;
+	ElGMID             = new std::vector<int>;
+	PhPt               = new std::vector<float>;
+	TauPt              = new std::vector<float>;
+	JetPt              = new std::vector<float>;
+	JetRawPt           = new std::vector<float>;
+	JetEta             = new std::vector<float>;
+	JetPhi             = new std::vector<float>;
+	JetEnergy          = new std::vector<float>;
+	JetCSVBTag         = new std::vector<float>;
+	JetPartonFlav      = new std::vector<int>;
+	JetBetaStar        = new std::vector<float>;
+
+}
+
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR SETTING PARAMETERS                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void SyntheticSample::SetMultiplicities(float muons, float electrons, float jets){
+	/*
+	sets the mean numbers of muons, electrons and jets per event, the numbers
+	themselves are Poisson distributed
+	parameters: muons, electrons, jets
+	return: none
+	*/
+
+	kMeanMuons     = muons;
+	kMeanElectrons = electrons;
+	kMeanJets      = jets;
+
+}
+
+
+//____________________________________________________________________________
+void SyntheticSample::SetSeed(unsigned int seed){
+	/*
+	sets the seed of the random generator and restarts the event numbering
+	parameters: seed
+	return: none
+	*/
+
+	kRandom -> SetSeed(seed);
+	kEventNumber = 0;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR GENERATING EVENTS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void SyntheticSample::CopyEventTo(Base * event){
+	/*
+	copies the current event into another Base instance (e.g. a Dileptons
+	instance) without any I/O; the vector leaves are shared, not copied
+	parameters: event
+	return: none
+	*/
+
+	event -> Run                      = Run;
+	event -> Lumi                     = Lumi;
+	event -> Event                    = Event;
+	event -> HLT_MU17_MU8             = HLT_MU17_MU8;
+	event -> HLT_MU17_TKMU8           = HLT_MU17_TKMU8;
+	event -> HLT_ELE17_ELE8_TIGHT     = HLT_ELE17_ELE8_TIGHT;
+	event -> HLT_MU8_ELE17_TIGHT      = HLT_MU8_ELE17_TIGHT;
+	event -> HLT_MU17_ELE8_TIGHT      = HLT_MU17_ELE8_TIGHT;
+	event -> HLT_MU8                  = HLT_MU8;
+	event -> HLT_MU17                 = HLT_MU17;
+	event -> HLT_MU5                  = HLT_MU5;
+	event -> HLT_MU12                 = HLT_MU12;
+	event -> HLT_MU24                 = HLT_MU24;
+	event -> HLT_MU40                 = HLT_MU40;
+	event -> HLT_ELE17_TIGHT          = HLT_ELE17_TIGHT;
+	event -> HLT_ELE17_JET30_TIGHT    = HLT_ELE17_JET30_TIGHT;
+	event -> HLT_ELE8_TIGHT           = HLT_ELE8_TIGHT;
+	event -> HLT_ELE8_JET30_TIGHT     = HLT_ELE8_JET30_TIGHT;
+	event -> NVrtx                    = NVrtx;
+	event -> NTrue                    = NTrue;
+	event -> PUWeight                 = PUWeight;
+	event -> PUWeightUp               = PUWeightUp;
+	event -> PUWeightDn               = PUWeightDn;
+	event -> GenWeight                = GenWeight;
+	event -> pfMET                    = pfMET;
+	event -> pfMETPhi                 = pfMETPhi;
+	event -> pfMET1                   = pfMET1;
+	event -> pfMET1Phi                = pfMET1Phi;
+
+	event -> MuPt               = MuPt;
+	event -> MuEta              = MuEta;
+	event -> MuPhi              = MuPhi;
+	event -> MuCharge           = MuCharge;
+	event -> MuPFIso            = MuPFIso;
+	event -> MuD0               = MuD0;
+	event -> MuIsGlobalMuon     = MuIsGlobalMuon;
+	event -> MuIsPFMuon         = MuIsPFMuon;
+	event -> MuNChi2            = MuNChi2;
+	event -> MuNMatchedStations = MuNMatchedStations;
+	event -> MuDz               = MuDz;
+	event -> MuNSiLayers        = MuNSiLayers;
+	event -> MuD0BS             = MuD0BS;
+	event -> MuIso03SumPt       = MuIso03SumPt;
+	event -> MuIso03EmPt        = MuIso03EmPt;
+	event -> MuIso03HadPt       = MuIso03HadPt;
+	event -> MuIsVeto           = MuIsVeto;
+	event -> MuIsLoose          = MuIsLoose;
+	event -> MuIsTight          = MuIsTight;
+	event -> MuIsPrompt         = MuIsPrompt;
+	event -> MuID               = MuID;
+	event -> MuMID              = MuMID;
+	event -> MuGMID             = MuGMID;
+	event -> ElPt               = ElPt;
+	event -> ElEta              = ElEta;
+	event -> ElPhi              = ElPhi;
+	event -> ElCharge           = ElCharge;
+	event -> ElPFIso            = ElPFIso;
+	event -> ElD0               = ElD0;
+	event -> ElChCo             = ElChCo;
+	event -> ElIsVeto           = ElIsVeto;
+	event -> ElIsLoose          = ElIsLoose;
+	event -> ElIsTight          = ElIsTight;
+	event -> ElIsPrompt         = ElIsPrompt;
+	event -> ElID               = ElID;
+	event -> ElMID              = ElMID;
+	event -> ElGMID             = ElGMID;
+	event -> PhPt               = PhPt;
+	event -> TauPt              = TauPt;
+	event -> JetPt              = JetPt;
+	event -> JetRawPt           = JetRawPt;
+	event -> JetEta             = JetEta;
+	event -> JetPhi             = JetPhi;
+	event -> JetEnergy          = JetEnergy;
+	event -> JetCSVBTag         = JetCSVBTag;
+	event -> JetPartonFlav      = JetPartonFlav;
+	event -> JetBetaStar        = JetBetaStar;
+
+}
+
+
+//____________________________________________________________________________
+void SyntheticSample::GenerateElectrons(){
+	/*
+	generates the electrons of the event, ordered in pt
+	parameters: none
+	return: none
+	*/
+
+	std::vector<float> pts = GeneratePts(kRandom -> Poisson(kMeanElectrons), 7., 25.);
+
+	ElPt -> clear(); ElEta -> clear(); ElPhi -> clear(); ElCharge -> clear(); ElPFIso -> clear();
+	ElD0 -> clear(); ElChCo -> clear(); ElIsVeto -> clear(); ElIsLoose -> clear(); ElIsTight -> clear();
+	ElIsPrompt -> clear(); ElID -> clear(); ElMID -> clear(); ElGMID -> clear();
+
+	for(int i = 0; i < pts.size(); ++i){
+		int charge   = kRandom -> Rndm() < 0.5 ? -1 : 1;
+		bool prompt  = kRandom -> Rndm() < 0.5;
+		float iso    = prompt ? kRandom -> Exp(0.05) : kRandom -> Exp(0.4);
+		bool veto    = kRandom -> Rndm() < 0.9;
+		bool loose   = veto  && iso < 0.6 && kRandom -> Rndm() < 0.8;
+		bool tight   = loose && iso < 0.1 && kRandom -> Rndm() < 0.7;
+
+		ElPt       -> push_back(pts[i]);
+		ElEta      -> push_back(kRandom -> Uniform(-2.5, 2.5));
+		ElPhi      -> push_back(kRandom -> Uniform(-TMath::Pi(), TMath::Pi()));
+		ElCharge   -> push_back(charge);
+		ElPFIso    -> push_back(iso);
+		ElD0       -> push_back(kRandom -> Gaus(0., prompt ? 0.005 : 0.03));
+		ElChCo     -> push_back(kRandom -> Rndm() < 0.95 ? 1. : 0.);
+		ElIsVeto   -> push_back(veto);
+		ElIsLoose  -> push_back(loose);
+		ElIsTight  -> push_back(tight);
+		ElIsPrompt -> push_back(prompt);
+		ElID       -> push_back(-11 * charge);
+		ElMID      -> push_back(prompt ? 23 : 111);
+		ElGMID     -> push_back(prompt ? 0 : 1);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void SyntheticSample::GenerateEvent(){
+	/*
+	generates a new random event, i.e. fills all leaves
+	parameters: none
+	return: none
+	*/
+
+	++kEventNumber;
+
+	Run   = 190000 + (int) (kEventNumber / 1000000);
+	Lumi  = 1 + (int) (kEventNumber / 1000) % 1000;
+	Event = (int) kEventNumber;
+
+	HLT_MU17_MU8          = kRandom -> Rndm() < 0.3;
+	HLT_MU17_TKMU8        = kRandom -> Rndm() < 0.3;
+	HLT_ELE17_ELE8_TIGHT  = kRandom -> Rndm() < 0.2;
+	HLT_MU8_ELE17_TIGHT   = kRandom -> Rndm() < 0.1;
+	HLT_MU17_ELE8_TIGHT   = kRandom -> Rndm() < 0.1;
+	HLT_MU8               = kRandom -> Rndm() < 0.5;
+	HLT_MU17              = kRandom -> Rndm() < 0.4;
+	HLT_MU5               = kRandom -> Rndm() < 0.6;
+	HLT_MU12              = kRandom -> Rndm() < 0.5;
+	HLT_MU24              = kRandom -> Rndm() < 0.2;
+	HLT_MU40              = kRandom -> Rndm() < 0.1;
+	HLT_ELE17_TIGHT       = kRandom -> Rndm() < 0.2;
+	HLT_ELE17_JET30_TIGHT = kRandom -> Rndm() < 0.2;
+	HLT_ELE8_TIGHT        = kRandom -> Rndm() < 0.3;
+	HLT_ELE8_JET30_TIGHT  = kRandom -> Rndm() < 0.3;
+
+	HLT_MU17_MU8_PS = HLT_MU17_TKMU8_PS = HLT_ELE17_ELE8_TIGHT_PS = HLT_MU8_ELE17_TIGHT_PS = HLT_MU17_ELE8_TIGHT_PS = 1;
+	HLT_MU8_PS = HLT_MU17_PS = HLT_MU5_PS = HLT_MU12_PS = HLT_MU24_PS = HLT_MU40_PS = 1;
+	HLT_ELE17_TIGHT_PS = HLT_ELE17_JET30_TIGHT_PS = HLT_ELE8_TIGHT_PS = HLT_ELE8_JET30_TIGHT_PS = 1;
+
+	NTrue      = kRandom -> Poisson(20.);
+	NVrtx      = kRandom -> Poisson(0.7 * NTrue);
+	PUWeight   = TMath::Max(0.05, kRandom -> Gaus(1., 0.3));
+	PUWeightUp = 1.05 * PUWeight;
+	PUWeightDn = 0.95 * PUWeight;
+	GenWeight  = 1.;
+
+	GenerateMuons();
+	GenerateElectrons();
+	GenerateJets();
+
+	PhPt  -> clear();
+	TauPt -> clear();
+
+	pfMET     = kRandom -> Exp(30.);
+	pfMETPhi  = kRandom -> Uniform(-TMath::Pi(), TMath::Pi());
+	pfMET1    = pfMET * kRandom -> Gaus(1., 0.05);
+	pfMET1Phi = pfMETPhi;
+
+}
+
+
+//____________________________________________________________________________
+void SyntheticSample::GenerateJets(){
+	/*
+	generates the jets of the event, ordered in pt; about 15% of them are b jets
+	parameters: none
+	return: none
+	*/
+
+	std::vector<float> pts = GeneratePts(kRandom -> Poisson(kMeanJets), 15., 40.);
+
+	JetPt -> clear(); JetRawPt -> clear(); JetEta -> clear(); JetPhi -> clear(); JetEnergy -> clear();
+	JetCSVBTag -> clear(); JetPartonFlav -> clear(); JetBetaStar -> clear();
+
+	for(int i = 0; i < pts.size(); ++i){
+		float eta = kRandom -> Uniform(-2.5, 2.5);
+		bool bjet = kRandom -> Rndm() < 0.15;
+
+		JetPt         -> push_back(pts[i]);
+		JetRawPt      -> push_back(pts[i] * kRandom -> Gaus(0.9, 0.05));
+		JetEta        -> push_back(eta);
+		JetPhi        -> push_back(kRandom -> Uniform(-TMath::Pi(), TMath::Pi()));
+		JetEnergy     -> push_back(pts[i] * TMath::CosH(eta));
+		JetCSVBTag    -> push_back(bjet ? kRandom -> Uniform(0.5, 1.) : TMath::Min(1., kRandom -> Exp(0.2)));
+		JetPartonFlav -> push_back(bjet ? 5 : (kRandom -> Rndm() < 0.5 ? 21 : 1));
+		JetBetaStar   -> push_back(kRandom -> Exp(0.1));
+	}
+
+}
+
+
+//____________________________________________________________________________
+void SyntheticSample::GenerateMuons(){
+	/*
+	generates the muons of the event, ordered in pt
+	parameters: none
+	return: none
+	*/
+
+	std::vector<float> pts = GeneratePts(kRandom -> Poisson(kMeanMuons), 5., 20.);
+
+	MuPt -> clear(); MuEta -> clear(); MuPhi -> clear(); MuCharge -> clear(); MuPFIso -> clear();
+	MuD0 -> clear(); MuIsGlobalMuon -> clear(); MuIsPFMuon -> clear(); MuNChi2 -> clear();
+	MuNMatchedStations -> clear(); MuDz -> clear(); MuNSiLayers -> clear(); MuD0BS -> clear();
+	MuIso03SumPt -> clear(); MuIso03EmPt -> clear(); MuIso03HadPt -> clear(); MuIsVeto -> clear();
+	MuIsLoose -> clear(); MuIsTight -> clear(); MuIsPrompt -> clear(); MuID -> clear();
+	MuMID -> clear(); MuGMID -> clear();
+
+	for(int i = 0; i < pts.size(); ++i){
+		int charge   = kRandom -> Rndm() < 0.5 ? -1 : 1;
+		bool prompt  = kRandom -> Rndm() < 0.5;
+		float iso    = prompt ? kRandom -> Exp(0.05) : kRandom -> Exp(0.4);
+		bool veto    = kRandom -> Rndm() < 0.95;
+		bool loose   = veto  && kRandom -> Rndm() < 0.85;
+		bool tight   = loose && iso < 0.1 && kRandom -> Rndm() < 0.8;
+
+		MuPt               -> push_back(pts[i]);
+		MuEta              -> push_back(kRandom -> Uniform(-2.4, 2.4));
+		MuPhi              -> push_back(kRandom -> Uniform(-TMath::Pi(), TMath::Pi()));
+		MuCharge           -> push_back(charge);
+		MuPFIso            -> push_back(iso);
+		MuD0               -> push_back(kRandom -> Gaus(0., prompt ? 0.005 : 0.03));
+		MuIsGlobalMuon     -> push_back(kRandom -> Rndm() < 0.95);
+		MuIsPFMuon         -> push_back(kRandom -> Rndm() < 0.97);
+		MuNChi2            -> push_back(kRandom -> Exp(2.));
+		MuNMatchedStations -> push_back(1 + kRandom -> Poisson(2.));
+		MuDz               -> push_back(kRandom -> Gaus(0., 0.05));
+		MuNSiLayers        -> push_back(5 + kRandom -> Poisson(5.));
+		MuD0BS             -> push_back(kRandom -> Gaus(0., prompt ? 0.005 : 0.03));
+		MuIso03SumPt       -> push_back(iso * pts[i] * 0.5);
+		MuIso03EmPt        -> push_back(iso * pts[i] * 0.3);
+		MuIso03HadPt       -> push_back(iso * pts[i] * 0.2);
+		MuIsVeto           -> push_back(veto);
+		MuIsLoose          -> push_back(loose);
+		MuIsTight          -> push_back(tight);
+		MuIsPrompt         -> push_back(prompt);
+		MuID               -> push_back(-13 * charge);
+		MuMID              -> push_back(prompt ? 23 : 511);
+		MuGMID             -> push_back(prompt ? 0 : 1);
+	}
+
+}
+
+
+//____________________________________________________________________________
+std::vector<float> SyntheticSample::GeneratePts(int number, float minimum, float slope){
+	/*
+	generates exponentially falling transverse momenta above a threshold,
+	ordered decreasingly like in the minitrees
+	parameters: number (number of objects), minimum (threshold), slope (mean above threshold)
+	return: vector of pts
+	*/
+
+	std::vector<float> pts;
+
+	for(int i = 0; i < number; ++i)
+		pts.push_back(minimum + kRandom -> Exp(slope));
+
+	std::sort(pts.begin(), pts.end(), std::greater<float>());
+
+	return pts;
+
+}
+
+
+//____________________________________________________________________________
+bool SyntheticSample::Write(std::string file_path, Long64_t entries){
+	/*
+	generates a number of events and writes them into a minitree "Analysis" in
+	a new ROOT file together with the "EventCount" histogram
+	parameters: file_path, entries (number of events)
+	return: true (if written successfully), false (else)
+	*/
+
+	TFile * root_file = new TFile(file_path.c_str(), "RECREATE");
+	if(root_file -> IsZombie()) {
+		delete root_file;
+		return false;
+	}
+
+	TTree * tree = new TTree("Analysis", "Analysis");
+
+	tree -> Branch("Run"                     , &Run                     , "Run/I"                     );
+	tree -> Branch("Lumi"                    , &Lumi                    , "Lumi/I"                    );
+	tree -> Branch("Event"                   , &Event                   , "Event/I"                   );
+	tree -> Branch("HLT_MU17_MU8"            , &HLT_MU17_MU8            , "HLT_MU17_MU8/I"            );
+	tree -> Branch("HLT_MU17_MU8_PS"         , &HLT_MU17_MU8_PS         , "HLT_MU17_MU8_PS/I"         );
+	tree -> Branch("HLT_MU17_TKMU8"          , &HLT_MU17_TKMU8          , "HLT_MU17_TKMU8/I"          );
+	tree -> Branch("HLT_MU17_TKMU8_PS"       , &HLT_MU17_TKMU8_PS       , "HLT_MU17_TKMU8_PS/I"       );
+	tree -> Branch("HLT_ELE17_ELE8_TIGHT"    , &HLT_ELE17_ELE8_TIGHT    , "HLT_ELE17_ELE8_TIGHT/I"    );
+	tree -> Branch("HLT_ELE17_ELE8_TIGHT_PS" , &HLT_ELE17_ELE8_TIGHT_PS , "HLT_ELE17_ELE8_TIGHT_PS/I" );
+	tree -> Branch("HLT_MU8_ELE17_TIGHT"     , &HLT_MU8_ELE17_TIGHT     , "HLT_MU8_ELE17_TIGHT/I"     );
+	tree -> Branch("HLT_MU8_ELE17_TIGHT_PS"  , &HLT_MU8_ELE17_TIGHT_PS  , "HLT_MU8_ELE17_TIGHT_PS/I"  );
+	tree -> Branch("HLT_MU17_ELE8_TIGHT"     , &HLT_MU17_ELE8_TIGHT     , "HLT_MU17_ELE8_TIGHT/I"     );
+	tree -> Branch("HLT_MU17_ELE8_TIGHT_PS"  , &HLT_MU17_ELE8_TIGHT_PS  , "HLT_MU17_ELE8_TIGHT_PS/I"  );
+	tree -> Branch("HLT_MU8"                 , &HLT_MU8                 , "HLT_MU8/I"                 );
+	tree -> Branch("HLT_MU8_PS"              , &HLT_MU8_PS              , "HLT_MU8_PS/I"              );
+	tree -> Branch("HLT_MU17"                , &HLT_MU17                , "HLT_MU17/I"                );
+	tree -> Branch("HLT_MU17_PS"             , &HLT_MU17_PS             , "HLT_MU17_PS/I"             );
+	tree -> Branch("HLT_MU5"                 , &HLT_MU5                 , "HLT_MU5/I"                 );
+	tree -> Branch("HLT_MU5_PS"              , &HLT_MU5_PS              , "HLT_MU5_PS/I"              );
+	tree -> Branch("HLT_MU12"                , &HLT_MU12                , "HLT_MU12/I"                );
+	tree -> Branch("HLT_MU12_PS"             , &HLT_MU12_PS             , "HLT_MU12_PS/I"             );
+	tree -> Branch("HLT_MU24"                , &HLT_MU24                , "HLT_MU24/I"                );
+	tree -> Branch("HLT_MU24_PS"             , &HLT_MU24_PS             , "HLT_MU24_PS/I"             );
+	tree -> Branch("HLT_MU40"                , &HLT_MU40                , "HLT_MU40/I"                );
+	tree -> Branch("HLT_MU40_PS"             , &HLT_MU40_PS             , "HLT_MU40_PS/I"             );
+	tree -> Branch("HLT_ELE17_TIGHT"         , &HLT_ELE17_TIGHT         , "HLT_ELE17_TIGHT/I"         );
+	tree -> Branch("HLT_ELE17_TIGHT_PS"      , &HLT_ELE17_TIGHT_PS      , "HLT_ELE17_TIGHT_PS/I"      );
+	tree -> Branch("HLT_ELE17_JET30_TIGHT"   , &HLT_ELE17_JET30_TIGHT   , "HLT_ELE17_JET30_TIGHT/I"   );
+	tree -> Branch("HLT_ELE17_JET30_TIGHT_PS", &HLT_ELE17_JET30_TIGHT_PS, "HLT_ELE17_JET30_TIGHT_PS/I");
+	tree -> Branch("HLT_ELE8_TIGHT"          , &HLT_ELE8_TIGHT          , "HLT_ELE8_TIGHT/I"          );
+	tree -> Branch("HLT_ELE8_TIGHT_PS"       , &HLT_ELE8_TIGHT_PS       , "HLT_ELE8_TIGHT_PS/I"       );
+	tree -> Branch("HLT_ELE8_JET30_TIGHT"    , &HLT_ELE8_JET30_TIGHT    , "HLT_ELE8_JET30_TIGHT/I"    );
+	tree -> Branch("HLT_ELE8_JET30_TIGHT_PS" , &HLT_ELE8_JET30_TIGHT_PS , "HLT_ELE8_JET30_TIGHT_PS/I" );
+	tree -> Branch("NVrtx"                   , &NVrtx                   , "NVrtx/I"                   );
+	tree -> Branch("NTrue"                   , &NTrue                   , "NTrue/I"                   );
+	tree -> Branch("PUWeight"                , &PUWeight                , "PUWeight/F"                );
+	tree -> Branch("PUWeightUp"              , &PUWeightUp              , "PUWeightUp/F"              );
+	tree -> Branch("PUWeightDn"              , &PUWeightDn              , "PUWeightDn/F"              );
+	tree -> Branch("GenWeight"               , &GenWeight               , "GenWeight/F"               );
+	tree -> Branch("pfMET"                   , &pfMET                   , "pfMET/F"                   );
+	tree -> Branch("pfMETPhi"                , &pfMETPhi                , "pfMETPhi/F"                );
+	tree -> Branch("pfMET1"                  , &pfMET1                  , "pfMET1/F"                  );
+	tree -> Branch("pfMET1Phi"               , &pfMET1Phi               , "pfMET1Phi/F"               );
+
+	tree -> Branch("MuPt"              , &MuPt              );
+	tree -> Branch("MuEta"             , &MuEta             );
+	tree -> Branch("MuPhi"             , &MuPhi             );
+	tree -> Branch("MuCharge"          , &MuCharge          );
+	tree -> Branch("MuPFIso"           , &MuPFIso           );
+	tree -> Branch("MuD0"              , &MuD0              );
+	tree -> Branch("MuIsGlobalMuon"    , &MuIsGlobalMuon    );
+	tree -> Branch("MuIsPFMuon"        , &MuIsPFMuon        );
+	tree -> Branch("MuNChi2"           , &MuNChi2           );
+	tree -> Branch("MuNMatchedStations", &MuNMatchedStations);
+	tree -> Branch("MuDz"              , &MuDz              );
+	tree -> Branch("MuNSiLayers"       , &MuNSiLayers       );
+	tree -> Branch("MuD0BS"            , &MuD0BS            );
+	tree -> Branch("MuIso03SumPt"      , &MuIso03SumPt      );
+	tree -> Branch("MuIso03EmPt"       , &MuIso03EmPt       );
+	tree -> Branch("MuIso03HadPt"      , &MuIso03HadPt      );
+	tree -> Branch("MuIsVeto"          , &MuIsVeto          );
+	tree -> Branch("MuIsLoose"         , &MuIsLoose         );
+	tree -> Branch("MuIsTight"         , &MuIsTight         );
+	tree -> Branch("MuIsPrompt"        , &MuIsPrompt        );
+	tree -> Branch("MuID"              , &MuID              );
+	tree -> Branch("MuMID"             , &MuMID             );
+	tree -> Branch("MuGMID"            , &MuGMID            );
+	tree -> Branch("ElPt"              , &ElPt              );
+	tree -> Branch("ElEta"             , &ElEta             );
+	tree -> Branch("ElPhi"             , &ElPhi             );
+	tree -> Branch("ElCharge"          , &ElCharge          );
+	tree -> Branch("ElPFIso"           , &ElPFIso           );
+	tree -> Branch("ElD0"              , &ElD0              );
+	tree -> Branch("ElChCo"            , &ElChCo            );
+	tree -> Branch("ElIsVeto"          , &ElIsVeto          );
+	tree -> Branch("ElIsLoose"         , &ElIsLoose         );
+	tree -> Branch("ElIsTight"         , &ElIsTight         );
+	tree -> Branch("ElIsPrompt"        , &ElIsPrompt        );
+	tree -> Branch("ElID"              , &ElID              );
+	tree -> Branch("ElMID"             , &ElMID             );
+	tree -> Branch("ElGMID"            , &ElGMID            );
+	tree -> Branch("JetPt"             , &JetPt             );
+	tree -> Branch("JetRawPt"          , &JetRawPt          );
+	tree -> Branch("JetEta"            , &JetEta            );
+	tree -> Branch("JetPhi"            , &JetPhi            );
+	tree -> Branch("JetEnergy"         , &JetEnergy         );
+	tree -> Branch("JetCSVBTag"        , &JetCSVBTag        );
+	tree -> Branch("JetPartonFlav"     , &JetPartonFlav     );
+	tree -> Branch("JetBetaStar"       , &JetBetaStar       );
+
+	TH1F * event_count = new TH1F("EventCount", "EventCount", 1, 0., 1.);
+
+	for(Long64_t i = 0; i < entries; ++i){
+		GenerateEvent();
+		tree -> Fill();
+		event_count -> Fill(0.5);
+	}
+
+	root_file -> Write();
+	root_file -> Close();
+	delete root_file;
+
+	return true;
+
+}
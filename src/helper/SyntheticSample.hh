@@ -0,0 +1,67 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+#ifndef SYNTHETICSAMPLE_HH
+#define SYNTHETICSAMPLE_HH
+
+#include "TMath.h"
+#include "TString.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TTree.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "src/head/Base.hh"
+
+
+
+class SyntheticSample: public Base{
+
+public:
+
+	// Member Functions
+
+	SyntheticSample(unsigned int = 4357);
+	virtual ~SyntheticSample();
+	virtual void Initialize(unsigned int);
+
+	void SetMultiplicities(float, float, float);
+	void SetSeed(unsigned int);
+
+	void CopyEventTo(Base *);
+	void GenerateEvent();
+	bool Write(std::string, Long64_t);
+
+
+private:
+
+	void GenerateElectrons();
+	void GenerateJets();
+	void GenerateMuons();
+	std::vector<float> GeneratePts(int, float, float);
+
+	Long64_t kEventNumber;
+	float kMeanElectrons;
+	float kMeanJets;
+	float kMeanMuons;
+	TRandom3 * kRandom;
+
+};
+
+
+#endif
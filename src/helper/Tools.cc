@@ -29,7 +29,7 @@ bool Tools::CheckDirectoryWritePermission(TString directory){
 	if(!test_file) return false;
 	
 	fclose(test_file);
-	system("rm " + directory + "0.txt");
+	unlink(directory + "0.txt");
 	
 	return true;
 }
@@ -142,7 +142,7 @@ std::string Tools::ConvertOutputTypeToStdString(OutputType value){
 
 
 //____________________________________________________________________________
-const char* Tools::ConvertStdStringToCString(std::string value){
+const char* Tools::ConvertStdStringToCString(const std::string & value){
 	/*
 	converts a std::string to a char*
 	parameters: value
@@ -155,7 +155,7 @@ const char* Tools::ConvertStdStringToCString(std::string value){
 
 
 //____________________________________________________________________________
-Label Tools::ConvertStdStringToLabel(std::string value){
+Label Tools::ConvertStdStringToLabel(const std::string & value){
 	/*
 	converts a std::string to Label
 	parameters: value
@@ -169,7 +169,7 @@ Label Tools::ConvertStdStringToLabel(std::string value){
 
 
 //____________________________________________________________________________
-TString Tools::ConvertStdStringToTString(std::string value){
+TString Tools::ConvertStdStringToTString(const std::string & value){
 	/*
 	converts a std::string to a TString
 	parameters: value
@@ -183,7 +183,7 @@ TString Tools::ConvertStdStringToTString(std::string value){
 
 
 //____________________________________________________________________________
-const char* Tools::ConvertTStringToCString(TString value){
+const char* Tools::ConvertTStringToCString(const TString & value){
 	/*
 	converts a TString to a char*
 	parameters: value (TString)
@@ -220,6 +220,7 @@ DileptonsRunOn Tools::ConvertTStringToDileptonsRunOn(TString value){
 	if     (value == "analysis") return analysis;
 	else if(value == "modules" ) return modules;
 	else if(value == "sketches") return sketches;
+	else if(value == "server"  ) return server;
 	else                         return modules;
 
 }
@@ -273,7 +274,7 @@ SampleType Tools::ConvertTStringToSampleType(TString value){
 
 
 //____________________________________________________________________________
-std::string Tools::ConvertTStringToStdString(TString value){
+std::string Tools::ConvertTStringToStdString(const TString & value){
 	/*
 	converts a TString to a std::string
 	parameters: value (TString)
@@ -286,7 +287,7 @@ std::string Tools::ConvertTStringToStdString(TString value){
 
 
 //____________________________________________________________________________
-std::vector<int> Tools::ConvertTStringVectorToIntVector(std::vector<TString> vector){
+std::vector<int> Tools::ConvertTStringVectorToIntVector(const std::vector<TString> & vector){
 	/*
 	converts a vector of TString into a vector of integers
 	parameters: vector (vector of TStrings)
@@ -304,7 +305,7 @@ std::vector<int> Tools::ConvertTStringVectorToIntVector(std::vector<TString> vec
 
 
 //____________________________________________________________________________
-int Tools::CountTStringOccurrence(TString haystack, TString needle, Ssiz_t position_start, Ssiz_t position_end){
+int Tools::CountTStringOccurrence(const TString & haystack, const TString & needle, Ssiz_t position_start, Ssiz_t position_end){
 	/*
 	counts the total number of occurences of a TString needle in a TString haystack
 	parameters: haystack (the underlying string), needle (the string whose occurrence
@@ -365,7 +366,26 @@ TString Tools::ExecuteShellScript(TString file_path){
 
 
 //____________________________________________________________________________
-std::vector<TString> Tools::ExplodeTString(TString string, TString delimiter){
+int Tools::ExecuteShellScriptText(TString script_text){
+    /*
+    executes the text of a shell script by piping it into a single bash process,
+    i.e. without writing, chmod'ing and removing a temporary script file
+    parameters: script_text (content of the shell script)
+    return: exit status of the shell, -1 if it could not be started
+    */
+
+    FILE * piped_input = popen("/bin/bash", "w");
+    if(!piped_input) return -1;
+
+    fputs(script_text, piped_input);
+
+    return pclose(piped_input);
+
+}
+
+
+//____________________________________________________________________________
+std::vector<TString> Tools::ExplodeTString(const TString & string, const TString & delimiter){
 	/*
 	explodes a TString into a vector of TStrings by breaking the string at
 	every delimiter
@@ -375,26 +395,14 @@ std::vector<TString> Tools::ExplodeTString(TString string, TString delimiter){
 	*/
 
 	std::vector<TString> vector;
-	TString element;
-
-	for(Ssiz_t position = 0; position <= string.Length(); ++position){
-		element += string(position, 1);
-
-		if(position == string.Length())
-			vector.push_back(element);
-
-		if(element(element.Length() - delimiter.Length(), delimiter.Length()) == delimiter){
-			vector.push_back(element(0, element.Length() - delimiter.Length()));
-			element = "";
-		}
-	}
+	Tools::ExplodeTString(string, delimiter, vector);
 	
 	return vector;
 }
 
 
 //____________________________________________________________________________
-std::vector<TString> Tools::GetColumnFromTStringMatrix(std::vector<std::vector<TString> > matrix, int column_index){
+std::vector<TString> Tools::GetColumnFromTStringMatrix(const std::vector<std::vector<TString> > & matrix, int column_index){
 	/*
 	takes out a single column from a matrix of TStrings
 	parameters: matrix (the matrix), column_index (the number of the column we take out)
@@ -412,7 +420,7 @@ std::vector<TString> Tools::GetColumnFromTStringMatrix(std::vector<std::vector<T
 
 
 //____________________________________________________________________________
-std::vector<TString> Tools::GetRowFromTStringMatrix(const std::vector<std::vector<TString> > matrix, int row_index){
+std::vector<TString> Tools::GetRowFromTStringMatrix(const std::vector<std::vector<TString> > & matrix, int row_index){
 	/*
 	takes out a single row from a matrix of TStrings
 	parameters: matrix (the matrix), row_index (the number of the row we take out)
@@ -476,7 +484,29 @@ TString Tools::GetUserName(){
 
 
 //____________________________________________________________________________
-std::string Tools::JoinStdString(std::vector<std::string> vector, std::string delimiter){
+TString Tools::HashTString(const TString & string){
+	/*
+	returns the 64 bit FNV-1a hash of a string, used to recognize outputs and
+	definitions of earlier runs; unlike TString::Hash, it does not depend on the
+	ROOT version and collisions are negligible even for many outputs
+	parameters: string
+	return: hash (16 hex digits)
+	*/
+
+	ULong64_t hash = 14695981039346656037ULL;
+
+	for(Ssiz_t i = 0; i < string.Length(); ++i){
+		hash ^= (unsigned char) string[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return Form("%016llx", (unsigned long long) hash);
+
+}
+
+
+//____________________________________________________________________________
+std::string Tools::JoinStdString(const std::vector<std::string> & vector, const std::string & delimiter){
 	/*
 	joins the std::string elements of a vector and creates a single std::string
 	parameters: vector (the vector of std::string elements), delimiter (the
@@ -498,7 +528,7 @@ std::string Tools::JoinStdString(std::vector<std::string> vector, std::string de
 
 
 //____________________________________________________________________________
-TString Tools::JoinTString(std::vector<TString> vector, TString delimiter){
+TString Tools::JoinTString(const std::vector<TString> & vector, const TString & delimiter){
 	/*
 	joins the TString elements of a vector and creates a single TString
 	parameters: vector (the vector of TString elements), delimiter (the
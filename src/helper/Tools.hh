@@ -28,6 +28,7 @@
 #include <map>
 #include <time.h>
 #include <sstream>
+#include <unistd.h>
 
 #include "src/helper/CustomTypes.hh"
 
@@ -44,31 +45,34 @@ namespace Tools {
 	std::string ConvertIntToStdString(int);
 	TString ConvertIntToTString(int);
 	std::string ConvertOutputTypeToStdString(OutputType);
-	const char* ConvertStdStringToCString(std::string);
-	Label ConvertStdStringToLabel(std::string);
-	TString ConvertStdStringToTString(std::string);
-	const char* ConvertTStringToCString(TString);
+	const char* ConvertStdStringToCString(const std::string &);
+	Label ConvertStdStringToLabel(const std::string &);
+	TString ConvertStdStringToTString(const std::string &);
+	const char* ConvertTStringToCString(const TString &);
 	DileptonsMode ConvertTStringToDileptonsMode(TString);
 	DileptonsRunOn ConvertTStringToDileptonsRunOn(TString);
 	DileptonsVerbose ConvertTStringToDileptonsVerbose(TString);
 	OutputType ConvertTStringToOutputType(TString);
 	SampleType ConvertTStringToSampleType(TString);
-	std::string ConvertTStringToStdString(TString);
-	std::vector<int> ConvertTStringVectorToIntVector(std::vector<TString>);
-	int CountTStringOccurrence(TString, TString, Ssiz_t = 0, Ssiz_t = -1);
+	std::string ConvertTStringToStdString(const TString &);
+	std::vector<int> ConvertTStringVectorToIntVector(const std::vector<TString> &);
+	int CountTStringOccurrence(const TString &, const TString &, Ssiz_t = 0, Ssiz_t = -1);
 	int ExecuteBashCommand(std::string);
 	TString ExecuteShellScript(TString);
-	std::vector<TString> ExplodeTString(TString, TString);
-	std::vector<TString> GetColumnFromTStringMatrix(std::vector<std::vector<TString> >, int = 0);
-	std::vector<TString> GetRowFromTStringMatrix(std::vector<std::vector<TString> >, int = 0);
+	int ExecuteShellScriptText(TString);
+	std::vector<TString> ExplodeTString(const TString &, const TString &);
+	std::vector<TString> GetColumnFromTStringMatrix(const std::vector<std::vector<TString> > &, int = 0);
+	std::vector<TString> GetRowFromTStringMatrix(const std::vector<std::vector<TString> > &, int = 0);
 	std::string GetTimestamp();
 	TString GetUserName();
-	std::string JoinStdString(std::vector<std::string>, std::string);
-	TString JoinTString(std::vector<TString>, TString);
+	TString HashTString(const TString &);
+	std::string JoinStdString(const std::vector<std::string> &, const std::string &);
+	TString JoinTString(const std::vector<TString> &, const TString &);
 	void ReplaceAll(std::string&, const std::string, const std::string);
 	int ScanTStringFormat(TString, TString, std::vector<TString>&);
 
-	// Template members
+	// Template members, all containers are passed as const references such that
+	// calling them in the event loop does not copy the container
 
 
 	//____________________________________________________________________________
@@ -86,7 +90,41 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename KeyType, typename ValueType> bool FindElementInMapByKey(std::map<KeyType, ValueType> map, KeyType element){
+	template<typename VectorType> void ExplodeTString(const TString & string, const TString & delimiter, VectorType & vector){
+		/*
+		explodes a TString by breaking the string at every delimiter and appends
+		the pieces to a given vector, such that the caller decides where the
+		memory of the vector comes from
+		parameters: string (the string to explode), delimiter (the string at whose
+		            occurrence the string will be broken), vector (the vector to fill)
+		return: none
+		*/
+
+		if(delimiter.Length() == 0) {
+			vector.push_back(string);
+			return;
+		}
+
+		Ssiz_t start = 0;
+		Ssiz_t found;
+
+		while((found = string.Index(delimiter, start)) != kNPOS){
+			vector.push_back(string(start, found - start));
+			start = found + delimiter.Length();
+		}
+
+		vector.push_back(string(start, string.Length() - start));
+
+	}
+
+
+	//____________________________________________________________________________
+	template<typename KeyType, typename ValueType> bool FindElementInMapByKey(const std::map<KeyType, ValueType> & map, const KeyType & element){
+		/*
+		returns true if a map contains a given key
+		parameters: map (the map), element (the key we are looking for)
+		return: true (if the key is in map), false (else)
+		*/
 
 		if(map.find(element) != map.end()) return true;
 	
@@ -96,7 +134,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename VectorType> bool FindElementInVector(std::vector<VectorType> vector, VectorType element){
+	template<typename VectorType, typename AllocatorType> bool FindElementInVector(const std::vector<VectorType, AllocatorType> & vector, const VectorType & element){
 		/*
 		searches through the elements of a vector and returns true if it finds a given one
 		parameters: vector (the vector), element (the element we are looking for)
@@ -111,7 +149,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename ValueType> int GetElementIndexInVector(std::vector<ValueType> vector, ValueType element){
+	template<typename ValueType, typename AllocatorType> int GetElementIndexInVector(const std::vector<ValueType, AllocatorType> & vector, const ValueType & element){
 		/*
 		returns the index of an element in a vector, if it is part of the vector, 
 		otherwise it returns the length of the vector
@@ -125,7 +163,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename ValueType> int GetElementIndexByObjectName(std::vector<ValueType> vector, TString name){
+	template<typename ValueType> int GetElementIndexByObjectName(const std::vector<ValueType> & vector, const TString & name){
 		/*
 		searches through a vector of more complex elements, i.e. elements that may be
 		of custom type which has a method called "GetName()", and returns the index
@@ -135,7 +173,7 @@ namespace Tools {
 		*/
 		
 		for(int i = 0; i < vector.size(); ++i)
-			if(vector[i] -> GetName() = name)
+			if(vector[i] -> GetName() == name)
 				return i;
 		
 		return -1;
@@ -144,7 +182,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename ValueType> Label GetElementKeyByObjectName(const std::map<Label, ValueType> map, TString name){
+	template<typename ValueType> Label GetElementKeyByObjectName(const std::map<Label, ValueType> & map, const TString & name){
 		/*
 		searches through a map of more complex elements, i.e. elements that may be
 		of custom type which has a method called "GetName()", and returns the key
@@ -164,7 +202,7 @@ namespace Tools {
 	}
 
 	//____________________________________________________________________________
-	template<typename ValueType> std::map<Label, ValueType> GetSubSetOfMapByKeys(std::map<Label, ValueType> map, Label keys_beginning){
+	template<typename ValueType> std::map<Label, ValueType> GetSubSetOfMapByKeys(const std::map<Label, ValueType> & map, const Label & keys_beginning){
 		/*
 		selects a subset of a map according to a list of given keys
 		parameters: map (the parent map), keys (the vector of keys)
@@ -172,11 +210,11 @@ namespace Tools {
 		*/
 	
 		std::map<Label, ValueType> result;
-		typename std::map<Label, ValueType>::iterator i;
+		typename std::map<Label, ValueType>::const_iterator i;
 		
 		for(i = map.begin(); i != map.end(); ++i)
 			if(i -> first(0, keys_beginning.Length()) == keys_beginning)
-				result[i -> first] = map[i -> first];
+				result[i -> first] = i -> second;
 	
 		return result;
 	
@@ -184,7 +222,7 @@ namespace Tools {
 	
 	
 	//____________________________________________________________________________
-	template<typename ValueType> std::map<Label, ValueType> GetSubSetOfMapByKeys(std::map<Label, ValueType> map, std::vector<Label> keys){
+	template<typename ValueType> std::map<Label, ValueType> GetSubSetOfMapByKeys(const std::map<Label, ValueType> & map, const std::vector<Label> & keys){
 		/*
 		selects a subset of a map according to a list of given keys
 		parameters: map (the parent map), keys (the vector of keys)
@@ -192,11 +230,11 @@ namespace Tools {
 		*/
 		
 		std::map<Label, ValueType> result;
-		typename std::map<Label, ValueType>::iterator i;
+		typename std::map<Label, ValueType>::const_iterator i;
 		
 		for(i = map.begin(); i != map.end(); ++i)
 			if(std::find(keys.begin(), keys.end(), i->first) != keys.end())
-				result[i -> first] = map[i -> first];
+				result[i -> first] = i -> second;
 		
 		return result;
 	
@@ -204,7 +242,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename ValueType> std::map<Label, ValueType> GetSubSetOfMapByObjectNames(std::map<Label, ValueType> map, TString names_beginning){
+	template<typename ValueType> std::map<Label, ValueType> GetSubSetOfMapByObjectNames(const std::map<Label, ValueType> & map, const TString & names_beginning){
 		/*
 		selects a subset of a map according to a list of given keys
 		parameters: map (the parent map), keys (the vector of keys)
@@ -212,11 +250,11 @@ namespace Tools {
 		*/
 		
 		std::map<Label, ValueType> result;
-		typename std::map<Label, ValueType>::iterator i;
+		typename std::map<Label, ValueType>::const_iterator i;
 		
 		for(i = map.begin(); i != map.end(); ++i)
 			if(i -> second -> GetName()(0, names_beginning.Length()) == names_beginning)
-				result[i -> first] = map[i -> first];
+				result[i -> first] = i -> second;
 		
 		return result;
 	
@@ -224,7 +262,7 @@ namespace Tools {
 	
 	
 	//____________________________________________________________________________
-	template<typename ValueType> std::map<Label, ValueType> GetSubSetOfMapByObjectNames(std::map<Label, ValueType> map, std::vector<TString> names){
+	template<typename ValueType> std::map<Label, ValueType> GetSubSetOfMapByObjectNames(const std::map<Label, ValueType> & map, const std::vector<TString> & names){
 		/*
 		selects a subset of a map according to a list of given keys
 		parameters: map (the parent map), keys (the vector of keys)
@@ -232,11 +270,11 @@ namespace Tools {
 		*/
 		
 		std::map<Label, ValueType> result;
-		typename std::map<Label, ValueType>::iterator i;
+		typename std::map<Label, ValueType>::const_iterator i;
 		
 		for(i = map.begin(); i != map.end(); ++i)
 			if(std::find(names.begin(), names.end(), (i -> second) -> GetName()) != names.end())
-				result[i -> first] = map[i -> first];
+				result[i -> first] = i -> second;
 
 		return result;
 	
@@ -244,7 +282,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename ValueType> std::vector<ValueType> GetSubSetOfVectorByObjectNames(const std::vector<ValueType> vector, TString names_beginning){
+	template<typename ValueType> std::vector<ValueType> GetSubSetOfVectorByObjectNames(const std::vector<ValueType> & vector, const TString & names_beginning){
 		/*
 		selects a subset of a map according to a list of given keys
 		parameters: map (the parent map), keys (the vector of keys)
@@ -263,7 +301,7 @@ namespace Tools {
 	
 	
 	//____________________________________________________________________________
-	template<typename ValueType> std::vector<ValueType> GetSubSetOfVectorByObjectNames(const std::vector<ValueType> vector, std::vector<TString> names){
+	template<typename ValueType> std::vector<ValueType> GetSubSetOfVectorByObjectNames(const std::vector<ValueType> & vector, const std::vector<TString> & names){
 		/*
 		selects a subset of a map according to a list of given keys
 		parameters: map (the parent map), keys (the vector of keys)
@@ -282,7 +320,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename KeyType, typename ValueType> std::vector<KeyType> GetVectorFromMapKeys(const std::map<KeyType, ValueType> map){
+	template<typename KeyType, typename ValueType> std::vector<KeyType> GetVectorFromMapKeys(const std::map<KeyType, ValueType> & map){
 		/*
 		takes out all keys froma  map discarding all values, i.e. we end up with a vector
 		parameters: map (the map)
@@ -300,7 +338,7 @@ namespace Tools {
 	
 	
 	//____________________________________________________________________________
-	template<typename KeyType, typename ValueType> std::vector<ValueType> GetVectorFromMapValues(const std::map<KeyType, ValueType> map){
+	template<typename KeyType, typename ValueType> std::vector<ValueType> GetVectorFromMapValues(const std::map<KeyType, ValueType> & map){
 		/*
 		takes out all values from a map discarding all keys, i.e. we end up with a vector
 		parameters: map (the map)
@@ -319,7 +357,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename KeyType, typename ValueType> TString PrintContentsOfMap(const std::map<KeyType, ValueType> map, TString delimiter = "\n"){
+	template<typename KeyType, typename ValueType> TString PrintContentsOfMap(const std::map<KeyType, ValueType> & map, const TString & delimiter = "\n"){
 
 		TString content = "";
 		typename std::map<KeyType, ValueType>::const_iterator i;
@@ -341,7 +379,7 @@ namespace Tools {
 
 
 	//____________________________________________________________________________
-	template<typename ValueType> std::vector<ValueType> RemoveElementFromVector(std::vector<ValueType> vector, ValueType element){
+	template<typename ValueType> std::vector<ValueType> RemoveElementFromVector(const std::vector<ValueType> & vector, const ValueType & element){
 		/*
 		remove every element in a vector that matches a given value
 		parameters: vector (the vector), element (the given value)
@@ -73,6 +73,13 @@ void Verbose::Initialize(DileptonsVerbose verbose, std::string error_file_path,
 	
 	kStartTime = time(0);
 	kWrittenOutput = "STARTING DIlEPTONS\n";
+	kWorker = false;
+	kInstrumentationScope = std::make_pair(Label(""), Label(""));
+
+	kProgressInterval = 60;
+	kProgressTerminal = isatty(fileno(stdout));
+	StartModuleProgress(0);
+	StartSampleProgress("", 0, 0);
 
 	Talk(GetSystemMessageByID(0).ReplaceAll("__TIMESTAMP__", Tools::ConvertStdStringToTString(Tools::GetTimestamp())), 1);
 
@@ -130,6 +137,21 @@ void Verbose::SetNumberOfModules(int number_of_modules_left){
 }
 
 
+//____________________________________________________________________________
+void Verbose::SetProgressInterval(int new_value){
+	/*
+	sets the number of seconds between two progress lines written to the log
+	in batch jobs, i.e. if the output is not a terminal; on a terminal the
+	progress is refreshed every second
+	parameters: new_value
+	return: none
+	*/
+
+	kProgressInterval = new_value;
+
+}
+
+
 //____________________________________________________________________________
 void Verbose::SetSystemMessages(std::string system_file_path){
 	/*
@@ -302,6 +324,7 @@ void Verbose::ErrorAndExit(int error_id){
   	*/
 
 	Error(error_id);
+	if(kWorker) WriteWorkerFile();
 	exit(1);
 
 }
@@ -451,11 +474,521 @@ void Verbose::WriteLogFile(){
 	std::ofstream log_file;
 	log_file.open(kLogFilePath);
 	log_file << kWrittenOutput;
+	if(kTimers.size() > 0 || kCounters.size() > 0) log_file << PrintInstrumentation();
 	log_file << "CLOSING DILEPTONS\n";
 	log_file.close();
 
+	if(kTimers.size() > 0 || kCounters.size() > 0) {
+		TString json_file_path = kLogFilePath;
+		if(json_file_path.EndsWith(".log")) json_file_path = json_file_path(0, json_file_path.Length() - 4);
+		if(!WriteInstrumentation(Tools::ConvertTStringToStdString(json_file_path + ".json"))) Error(14);
+	}
+
+}
+
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR INSTRUMENTATION                                        **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void Verbose::Count(const char * name, long increment){
+	/*
+	increments a counter of the current module and sample; use the macro
+	INSTRUMENT_COUNT in the hot paths, which is empty unless INSTRUMENTATION is
+	defined
+	parameters: name, increment
+	return: none
+	*/
+
+	kCounters[kInstrumentationScope][name] += increment;
+
+}
+
+
+//____________________________________________________________________________
+double Verbose::GetTime(){
+	/*
+	returns the time of a monotonic clock
+	parameters: none
+	return: time in seconds
+	*/
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + 1.e-9 * now.tv_nsec;
+
+}
+
+
+//____________________________________________________________________________
+TString Verbose::PrintInstrumentation(){
+	/*
+	prints the summary of all timers and counters, per module and sample
+	parameters: none
+	return: summary
+	*/
+
+	std::map<std::pair<Label, Label>, bool> scopes;
+	for(std::map<std::pair<Label, Label>, std::map<std::string, InstrumentationRecord> >::iterator i = kTimers.begin(); i != kTimers.end(); ++i)
+		scopes[i -> first] = true;
+	for(std::map<std::pair<Label, Label>, std::map<std::string, long> >::iterator i = kCounters.begin(); i != kCounters.end(); ++i)
+		scopes[i -> first] = true;
+
+	TString summary = "INSTRUMENTATION\n";
+
+	for(std::map<std::pair<Label, Label>, bool>::iterator i = scopes.begin(); i != scopes.end(); ++i){
+
+		summary += Form("module %s, sample %s:\n", (i -> first.first == "") ? "none" : i -> first.first.Data(), (i -> first.second == "") ? "none" : i -> first.second.Data());
+
+		std::map<std::string, InstrumentationRecord> & timers = kTimers[i -> first];
+		for(std::map<std::string, InstrumentationRecord>::iterator j = timers.begin(); j != timers.end(); ++j)
+			summary += Form("  timer %-24s %10ld calls %10.3f s total %10.3f us mean %10.3f us min %10.3f us max\n",
+			                j -> first.c_str(), j -> second.calls, j -> second.total, 1.e6 * j -> second.total / j -> second.calls,
+			                1.e6 * j -> second.minimum, 1.e6 * j -> second.maximum);
+
+		std::map<std::string, long> & counters = kCounters[i -> first];
+		for(std::map<std::string, long>::iterator j = counters.begin(); j != counters.end(); ++j)
+			summary += Form("  counter %-22s %10ld\n", j -> first.c_str(), j -> second);
+	}
+
+	return summary;
+
+}
+
+
+//____________________________________________________________________________
+void Verbose::SetInstrumentationModule(Label module_name){
+	/*
+	sets the module that all following timers and counters belong to, the
+	sample is reset; modules fused into one loop are joined by + (e.g. 11+16)
+	parameters: module_name
+	return: none
+	*/
+
+	kInstrumentationScope = std::make_pair(module_name, Label(""));
+
+}
+
+
+//____________________________________________________________________________
+void Verbose::SetInstrumentationSample(Label sample_name){
+	/*
+	sets the sample that all following timers and counters belong to, an empty
+	name stands for work that is not done per sample (e.g. writing the output)
+	parameters: sample_name
+	return: none
+	*/
+
+	kInstrumentationScope.second = sample_name;
+
+}
+
+
+//____________________________________________________________________________
+void Verbose::Time(const char * name, double seconds){
+	/*
+	adds a measured time to a timer of the current module and sample, use the
+	macro INSTRUMENT_TIMER in the hot paths
+	parameters: name, seconds
+	return: none
+	*/
+
+	InstrumentationRecord & record = kTimers[kInstrumentationScope][name];
+
+	if(record.calls == 0 || seconds < record.minimum) record.minimum = seconds;
+	if(record.calls == 0 || seconds > record.maximum) record.maximum = seconds;
+	record.total += seconds;
+	++record.calls;
+
+	long nanoseconds = (long) (1.e9 * seconds);
+	int bin = 0;
+	while(nanoseconds > 1 && bin < 31){
+		nanoseconds >>= 1;
+		++bin;
+	}
+	++record.latencies[bin];
+
+}
+
+
+//____________________________________________________________________________
+bool Verbose::WriteInstrumentation(std::string file_path){
+	/*
+	writes all timers and counters into a JSON file, times are given in seconds,
+	latencies is the histogram of the call times in bins of [2^i, 2^(i+1)) ns
+	parameters: file_path
+	return: true (if written successfully), false (else)
+	*/
+
+	std::ofstream json_file(file_path.c_str());
+	if(!json_file.is_open()) return false;
+
+	std::map<std::pair<Label, Label>, bool> scopes;
+	for(std::map<std::pair<Label, Label>, std::map<std::string, InstrumentationRecord> >::iterator i = kTimers.begin(); i != kTimers.end(); ++i)
+		scopes[i -> first] = true;
+	for(std::map<std::pair<Label, Label>, std::map<std::string, long> >::iterator i = kCounters.begin(); i != kCounters.end(); ++i)
+		scopes[i -> first] = true;
+
+	json_file << "{\n  \"scopes\": [";
+
+	for(std::map<std::pair<Label, Label>, bool>::iterator i = scopes.begin(); i != scopes.end(); ++i){
+
+		json_file << ((i == scopes.begin()) ? "\n" : ",\n");
+		json_file << "    {\"module\": \"" << i -> first.first << "\", \"sample\": \"" << i -> first.second << "\",\n";
+
+		json_file << "     \"timers\": {";
+		std::map<std::string, InstrumentationRecord> & timers = kTimers[i -> first];
+		for(std::map<std::string, InstrumentationRecord>::iterator j = timers.begin(); j != timers.end(); ++j){
+			json_file << ((j == timers.begin()) ? "\n" : ",\n");
+			json_file << "       \"" << j -> first << "\": {\"calls\": " << j -> second.calls << ", \"total\": " << j -> second.total;
+			json_file << ", \"minimum\": " << j -> second.minimum << ", \"maximum\": " << j -> second.maximum << ", \"latencies\": [";
+			for(int k = 0; k < 32; ++k)
+				json_file << ((k > 0) ? ", " : "") << j -> second.latencies[k];
+			json_file << "]}";
+		}
+		json_file << "},\n";
+
+		json_file << "     \"counters\": {";
+		std::map<std::string, long> & counters = kCounters[i -> first];
+		for(std::map<std::string, long>::iterator j = counters.begin(); j != counters.end(); ++j)
+			json_file << ((j == counters.begin()) ? "" : ", ") << "\"" << j -> first << "\": " << j -> second;
+		json_file << "}}";
+	}
+
+	json_file << "\n  ]\n}\n";
+	json_file.close();
+
+	return true;
+
+}
+
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR WORKER PROCESSES                                       **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+TString Verbose::GetWorkerFilePath(int pid){
+	/*
+	returns the path of the file a worker process leaves its log and its
+	instrumentation in, next to the log file
+	parameters: pid (process ID of the worker)
+	return: file path
+	*/
+
+	return kLogFilePath + "." + Tools::ConvertIntToTString(pid);
+
+}
+
+
+//____________________________________________________________________________
+bool Verbose::ReadWorkerFile(int pid){
+	/*
+	merges the log and the instrumentation a worker process has left into the
+	ones of this process and removes the file; the log of the worker is
+	appended, counters and timers of the same scope are added up
+	parameters: pid (process ID of the worker)
+	return: true (if the file was read), false (else)
+	*/
+
+	TString file_path = GetWorkerFilePath(pid);
+	std::ifstream worker_file(file_path.Data());
+	if(!worker_file.is_open()) return false;
+
+	long length = 0;
+	worker_file >> length;
+	worker_file.ignore(1);
+	std::vector<char> log(length + 1, 0);
+	worker_file.read(&log[0], length);
+	kWrittenOutput += &log[0];
+
+	std::string type, module, sample, name;
+	while(std::getline(worker_file, type, '\t') && std::getline(worker_file, module, '\t') && std::getline(worker_file, sample, '\t') && std::getline(worker_file, name, '\t')){
+		std::pair<Label, Label> scope = std::make_pair(Label(module.c_str()), Label(sample.c_str()));
+
+		if(type == "counter") {
+			long value = 0;
+			worker_file >> value;
+			kCounters[scope][name] += value;
+		}
+		else {
+			InstrumentationRecord worker_record;
+			worker_file >> worker_record.calls >> worker_record.total >> worker_record.minimum >> worker_record.maximum;
+			for(int i = 0; i < 32; ++i)
+				worker_file >> worker_record.latencies[i];
+
+			InstrumentationRecord & record = kTimers[scope][name];
+			if(record.calls == 0 || worker_record.minimum < record.minimum) record.minimum = worker_record.minimum;
+			if(record.calls == 0 || worker_record.maximum > record.maximum) record.maximum = worker_record.maximum;
+			record.calls += worker_record.calls;
+			record.total += worker_record.total;
+			for(int i = 0; i < 32; ++i)
+				record.latencies[i] += worker_record.latencies[i];
+		}
+		worker_file.ignore(1);
+	}
+
+	worker_file.close();
+	remove(file_path.Data());
+
+	return true;
+
+}
+
+
+//____________________________________________________________________________
+void Verbose::StartWorker(){
+	/*
+	marks this process as a worker, right after it has been forked; the log and
+	the instrumentation inherited from the parent are dropped, such that the
+	worker file only holds what the worker adds
+	parameters: none
+	return: none
+	*/
+
+	kWorker        = true;
+	kWrittenOutput = "";
+	kCounters.clear();
+	kTimers  .clear();
+
+}
+
+
+//____________________________________________________________________________
+bool Verbose::WriteWorkerFile(){
+	/*
+	writes the log and the instrumentation of a worker process into its worker
+	file, which the parent merges by ReadWorkerFile once the worker is done;
+	the log comes first, preceded by its length, then one tab separated line
+	per counter and timer
+	parameters: none
+	return: true (if written successfully), false (else)
+	*/
+
+	std::ofstream worker_file(GetWorkerFilePath(getpid()).Data());
+	if(!worker_file.is_open()) return false;
+
+	worker_file << kWrittenOutput.Length() << "\n" << kWrittenOutput;
+	worker_file.precision(17);
+
+	for(std::map<std::pair<Label, Label>, std::map<std::string, long> >::iterator i = kCounters.begin(); i != kCounters.end(); ++i)
+		for(std::map<std::string, long>::iterator j = i -> second.begin(); j != i -> second.end(); ++j)
+			worker_file << "counter\t" << i -> first.first << "\t" << i -> first.second << "\t" << j -> first << "\t" << j -> second << "\n";
+
+	for(std::map<std::pair<Label, Label>, std::map<std::string, InstrumentationRecord> >::iterator i = kTimers.begin(); i != kTimers.end(); ++i){
+		for(std::map<std::string, InstrumentationRecord>::iterator j = i -> second.begin(); j != i -> second.end(); ++j){
+			worker_file << "timer\t" << i -> first.first << "\t" << i -> first.second << "\t" << j -> first << "\t";
+			worker_file << j -> second.calls << " " << j -> second.total << " " << j -> second.minimum << " " << j -> second.maximum;
+			for(int k = 0; k < 32; ++k)
+				worker_file << " " << j -> second.latencies[k];
+			worker_file << "\n";
+		}
+	}
+
+	worker_file.close();
+
+	return !worker_file.fail();
+
+}
+
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR PROGRESS REPORTING                                     **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void Verbose::EndSampleProgress(){
+	/*
+	reports the progress once more at the end of a sample and adds its entries
+	to the entries done in the module
+	parameters: none
+	return: none
+	*/
+
+	if(kProgressEntries == 0) return;
+
+	kProgressEntry = kProgressEntries;
+	TString progress = PrintProgress();
+
+	if(kProgressTerminal) std::cout << "\r>> " << progress << std::endl;
+	Write(progress);
+
+	kProgressEntriesDone += kProgressEntries;
+	kProgressEntries      = 0;
+
+}
+
+
+//____________________________________________________________________________
+TString Verbose::PrintDuration(double seconds){
+	/*
+	prints a duration in hours, minutes and seconds
+	parameters: seconds
+	return: duration
+	*/
+
+	int rounded = (int) (seconds + 0.5);
+
+	return Form("%dh %02dm %02ds", rounded / 3600, (rounded / 60) % 60, rounded % 60);
+
 }
 
 
+//____________________________________________________________________________
+TString Verbose::PrintProgress(){
+	/*
+	prints the progress of the current sample and module, i.e. the processed
+	entries, their rate, the rate of reading and the estimated time left
+	parameters: none
+	return: progress line
+	*/
+
+	double now             = GetTime();
+	double sample_seconds  = now - kProgressSampleStartTime;
+	double module_seconds  = now - kProgressModuleStartTime;
+	double entries_rate    = (sample_seconds > 0.) ? kProgressEntry / sample_seconds : 0.;
+	double bytes_rate      = (sample_seconds > 0.) ? kProgressBytes / sample_seconds : 0.;
+	Long64_t module_entry  = kProgressEntriesDone + kProgressEntry;
+	double module_rate     = (module_seconds > 0.) ? module_entry / module_seconds : 0.;
+
+	TString sample_eta = (entries_rate > 0.) ? PrintDuration((kProgressEntries       - kProgressEntry) / entries_rate) : "unknown";
+	TString module_eta = (module_rate  > 0.) ? PrintDuration((kProgressEntriesModule - module_entry  ) / module_rate ) : "unknown";
 
+	return Form("module %s (%d/%d), sample %s, %d selections: %5.1f%% (%lld/%lld), %.0f entries/s, %.2f MB/s, ETA sample %s, ETA module %s",
+	            kInstrumentationScope.first.Data(), kNumberOfAllModules - kNumberOfModulesLeft, kNumberOfAllModules, kProgressSample.Data(),
+	            kProgressSelections, (kProgressEntries > 0) ? 100. * kProgressEntry / kProgressEntries : 100., kProgressEntry,
+	            kProgressEntries, entries_rate, bytes_rate / 1.e6, sample_eta.Data(), module_eta.Data());
 
+}
+
+
+//____________________________________________________________________________
+void Verbose::Progress(Long64_t entry, Long64_t bytes){
+	/*
+	reports the progress of the event loop; it is called for every entry but
+	only looks at the clock every 1024 entries and only prints after one second
+	(terminal) or after the progress interval (batch job, written to the log)
+	parameters: entry (number of processed entries), bytes (number of bytes read
+	            from the files)
+	return: none
+	*/
+
+	if((entry & 1023) != 0) return;
+
+	double now = GetTime();
+
+	if(kProgressTerminal  && now - kProgressLastTime < 1.) return;
+	if(!kProgressTerminal && (kProgressInterval <= 0 || now - kProgressLastTime < kProgressInterval)) return;
+
+	kProgressEntry    = entry;
+	kProgressBytes    = bytes;
+	kProgressLastTime = now;
+	TString progress  = PrintProgress();
+
+	if(kProgressTerminal) {
+		std::cout << "\r>> " << progress << std::flush;
+	}
+	else {
+		Print(progress);
+		Write(progress);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void Verbose::StartModuleProgress(Long64_t entries){
+	/*
+	starts the progress reporting of a module
+	parameters: entries (number of entries of all samples in the module)
+	return: none
+	*/
+
+	kProgressEntriesDone     = 0;
+	kProgressEntriesModule   = entries;
+	kProgressModuleStartTime = GetTime();
+
+}
+
+
+//____________________________________________________________________________
+void Verbose::StartSampleProgress(Label sample_name, Long64_t entries, int number_of_selections){
+	/*
+	starts the progress reporting of a sample
+	parameters: sample_name, entries (number of entries to process),
+	            number_of_selections
+	return: none
+	*/
+
+	kProgressBytes           = 0;
+	kProgressEntries         = entries;
+	kProgressEntry           = 0;
+	kProgressSample          = sample_name;
+	kProgressSampleStartTime = GetTime();
+	kProgressLastTime        = kProgressSampleStartTime;
+	kProgressSelections      = number_of_selections;
+
+}
+
+
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS OF THE SCOPED TIMER                                        **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+ScopedTimer::ScopedTimer(Verbose * verbosity, const char * name){
+	/*
+	constructs the ScopedTimer class and starts the timer
+	parameters: verbosity, name (of the timer)
+	return: none
+	*/
+
+	kName      = name;
+	kVerbose   = verbosity;
+	kStartTime = Verbose::GetTime();
+
+}
+
+
+//____________________________________________________________________________
+ScopedTimer::~ScopedTimer(){
+	/*
+	destructs the ScopedTimer class and adds the time since construction to
+	the timer of the Verbose class
+	parameters: none
+	return: none
+	*/
+
+	kVerbose -> Time(kName, Verbose::GetTime() - kStartTime);
+
+}
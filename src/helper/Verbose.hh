@@ -16,7 +16,11 @@
 #include "TROOT.h"
 #include "TString.h"
 
+#include <stdio.h>
 #include <time.h>
+#include <unistd.h>
+#include <map>
+#include <string>
 
 #include "src/helper/CustomTypes.hh"
 #include "src/helper/OtherInput.hh"
@@ -37,6 +41,7 @@ public:
 	void SetErrorMessages(std::string);
 	void SetLogFilePath(std::string);
 	void SetNumberOfModules(int);
+	void SetProgressInterval(int);
 	void SetSystemMessages(std::string);
 	void SetVerbose(DileptonsVerbose);
 	void SetVerboseFromInt(int);
@@ -62,6 +67,23 @@ public:
 	void Talk(TString, int = 0, bool = false);
 	void Write(TString);
 	void WriteLogFile();
+
+	void Count(const char *, long = 1);
+	static double GetTime();
+	TString PrintInstrumentation();
+	void SetInstrumentationModule(Label);
+	void SetInstrumentationSample(Label);
+	void Time(const char *, double);
+	bool WriteInstrumentation(std::string);
+
+	void EndSampleProgress();
+	void Progress(Long64_t, Long64_t);
+	void StartModuleProgress(Long64_t);
+	void StartSampleProgress(Label, Long64_t, int);
+
+	bool ReadWorkerFile(int);
+	void StartWorker();
+	bool WriteWorkerFile();
 	
 
 private:
@@ -77,8 +99,66 @@ private:
 	std::vector<TString> kErrorMessages;
 	std::vector<TString> kSystemMessages;
 
+	std::pair<Label, Label> kInstrumentationScope;
+	std::map<std::pair<Label, Label>, std::map<std::string, long> > kCounters;
+	std::map<std::pair<Label, Label>, std::map<std::string, InstrumentationRecord> > kTimers;
+
+	TString PrintProgress();
+	TString PrintDuration(double);
+
+	TString GetWorkerFilePath(int);
+	bool kWorker;
+
+	Long64_t kProgressBytes;
+	Long64_t kProgressEntries;
+	Long64_t kProgressEntry;
+	Long64_t kProgressEntriesDone;
+	Long64_t kProgressEntriesModule;
+	int kProgressInterval;
+	double kProgressLastTime;
+	double kProgressModuleStartTime;
+	Label kProgressSample;
+	double kProgressSampleStartTime;
+	int kProgressSelections;
+	bool kProgressTerminal;
+
 	
 };
 
 
+class ScopedTimer{
+
+public:
+
+	// Member Functions
+
+	ScopedTimer(Verbose *, const char *);
+	~ScopedTimer();
+
+
+private:
+
+	const char * kName;
+	double kStartTime;
+	Verbose * kVerbose;
+
+};
+
+
+// The instrumentation of the hot paths is only compiled if INSTRUMENTATION
+// is defined (make INSTRUMENTATION=1), otherwise the macros expand to nothing.
+// A timer measures the time until the end of the scope it is declared in.
+
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_(a, b)
+#define INSTRUMENT_CONCAT_(a, b) a##b
+
+#ifdef INSTRUMENTATION
+#define INSTRUMENT_COUNT(verbose, name, increment) (verbose) -> Count(name, increment)
+#define INSTRUMENT_TIMER(verbose, name) ScopedTimer INSTRUMENT_CONCAT(scoped_timer_, __LINE__)(verbose, name)
+#else
+#define INSTRUMENT_COUNT(verbose, name, increment)
+#define INSTRUMENT_TIMER(verbose, name)
+#endif
+
+
 #endif
@@ -73,27 +73,95 @@ void AnalysisModules::Initialize(){
 	return: none
 	*/
 
+	kClosureTest          = false;
+	kEntryKernel          = 0;
+	kModulePassSelections = 0;
+
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::CallModuleByID(int module_id){
+std::vector<Label> AnalysisModules::AddKinematicVariations(std::vector<Label> selection_names){
 	/*
-	calls the module given by the module ID
-	parameters: module_id (unique number of the module)
+	appends one block of event selections per kinematic variation to the
+	nominal ones, named <selection>_<variation>; the outputs of a variation
+	then go to their own directories while the kernels stay the same
+	parameters: selection_names (the nominal event selections)
+	return: selection names of all variations
+	*/
+
+	std::vector<Label> all_selection_names = selection_names;
+
+	for(int i = 0; i < kKinematicVariationNames.size(); ++i)
+		for(int j = 0; j < selection_names.size(); ++j)
+			all_selection_names.push_back(selection_names[j] + "_" + kKinematicVariationNames[i]);
+
+	return all_selection_names;
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::AddModulePass(int module_id, void (AnalysisModules::*kernel)(float), void (AnalysisModules::*finish)(std::vector<Label>, std::vector<Label>), std::vector<Label> sample_names, std::vector<Label> selection_names, std::vector<Label> event_selection_names){
+	/*
+	declares the event loop of a module, whose output cache has been defined
+	before; the cache is moved into the pass, such that the next module can
+	define its own, and the loop is run later by RunModulePasses together with
+	the loops of other modules
+	parameters: module_id, *kernel (kernel called for every selected event),
+	            *finish (called with the samples and selections once the loop is
+	            done, writes the outputs), sample_names, selection_names (of the
+	            outputs), event_selection_names (parsed in the loop, none if the
+	            kernel sees every event)
+	return: none
+	*/
+
+	ModulePass pass;
+
+	pass.id                   = module_id;
+	pass.kernel               = kernel;
+	pass.finish               = finish;
+	pass.samples              = sample_names;
+	pass.selections           = selection_names;
+	pass.event_selections     = event_selection_names;
+	pass.number_of_selections = 0;
+	pass.number_of_variations = 0;
+
+	kModulePasses.push_back(pass);
+	SwapModulePassCache(kModulePasses.back());
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::CallModuleByID(int module_id, bool fuse){
+	/*
+	calls the module given by the module ID; the frame of the module declares
+	its pass, which is run right away unless it is fused with the passes of the
+	following modules
+	parameters: module_id (unique number of the module), fuse (true if the pass
+	            is run later by RunModulePasses)
 	return: none
 	*/
 
+	kVerbose -> SetInstrumentationModule(Form("%d", module_id));
+	kProfiler -> Clear();
+
 	switch(module_id){
 		case 11: Module11Frame(); break;  
 		case 12: Module12Frame(); break; 
 		case 13: Module13Frame(); break; 
 		//case 14: Module14Frame(); break; 
 		//case 15: Module15Frame(); break; 
-		//case 16: Module16Frame(); break; 
+		case 16: Module16Frame(); break; 
+		case 36: Module36Frame(); break; 
+		case 41: Module41Frame(); break; 
+		case 42: Module42Frame(); break; 
 		default: kVerbose->Error(); break;
 	}
 
+	if(!fuse) RunModulePasses();
+
 }
 
 
@@ -111,547 +179,2251 @@ void AnalysisModules::EndDileptons(){
 
 
 //____________________________________________________________________________
-void AnalysisModules::RunModules(){
+std::vector<Label> AnalysisModules::GetModuleDefinitionsByID(int module_id){
 	/*
-	running on selected modules given in kModules
-	parameters: none
-	return: none
+	returns the objects and defined variables the kernel of a module reads
+	directly, apart from those of its event selections; the variables of the
+	cut scan are given as written in ScanVariables (e.g. #GJ)
+	parameters: module_id (unique number of the module)
+	return: labels of the definitions
 	*/
 
+	std::vector<Label> definitions;
 
-	for(int i = 0; i < kModules.size(); ++i){
-		kVerbose -> Module();
-		CallModuleByID(kModules[i]);
+	switch(module_id){
+		case 11: definitions.push_back("LM"); definitions.push_back("TM"); break;
+		case 12: definitions.push_back("BJ"); definitions.push_back("GJ"); definitions.push_back("LM"); definitions.push_back("TM"); break;
+		case 36: for(int d = 0; d < kCutScan.GetNumberOfVariables(); ++d) definitions.push_back(kCutScan.GetVariable(d)); break;
+		case 41: definitions.push_back("LE"); definitions.push_back("LM"); break;
+		case 42: definitions.push_back("LE"); definitions.push_back("LM"); break;
+	}
+
+	return definitions;
+
+}
+
+
+//____________________________________________________________________________
+std::vector<Label> AnalysisModules::GetModuleInputsByID(int module_id){
+	/*
+	returns the products a module needs from other modules, they are handed
+	over in the memory
+	parameters: module_id (unique number of the module)
+	return: labels of the products
+	*/
+
+	std::vector<Label> inputs;
+
+	switch(module_id){
+		case 41: inputs.push_back("MuonFakeRatioMap"); break;
+		case 42: inputs.push_back("MuonFakeRatioMap"); break;
 	}
 
+	return inputs;
+
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::LoopOverEntries(void (AnalysisModules::*kernel)(float), Label sample_key){
+std::vector<Label> AnalysisModules::GetModuleOutputsByID(int module_id){
 	/*
-	performs a loop over the maximum number of entries in the sample and
-	calls a specific kernel function every iteration
-	parameters: *kernel (pointer to the kernel function to be called), sample_index
+	returns the products a module gives to other modules
+	parameters: module_id (unique number of the module)
+	return: labels of the products
+	*/
+
+	std::vector<Label> outputs;
+
+	switch(module_id){
+		case 11: outputs.push_back("MuonFakeRatioMap"); break;
+	}
+
+	return outputs;
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::RunModules(){
+	/*
+	running on selected modules given in kModules; every module starts as soon
+	as the products it needs (see GetModuleInputsByID) exist; the modules whose
+	products are needed by others run in this process, such that the products
+	stay in the memory, and with FuseModules they share one event loop; all
+	other modules are given to up to ModuleWorkers worker processes running in
+	parallel; the plots are rendered in the background while the next modules
+	run, and published to the AFS webspace once they are complete
+	parameters: none
 	return: none
-	*/ 
+	*/
 
-	// loop over entries	
-	for(kEntryIterator = 0; kEntryIterator < cSamples[sample_key] -> GetMaxEntries(); ++kEntryIterator) {
-		
-		// get tree entry, i.e. load branches
-		kRootTree -> GetEntry(kEntryIterator);
+	std::vector<int> pending = kModules;
+	std::vector<int> rendered;
 
-		// get event weight, PU reweight it if needed 
-		float event_weight = cSamples[sample_key] -> GetEventWeight();
-		if(cPileUpReweighting) event_weight *= PUWeight;
+	kModuleProducts.clear();
 
-		// call the kernel
-		(this->*kernel)(event_weight);
+	while(pending.size() > 0){
+
+		// the modules whose inputs exist, inputs that no pending module gives
+		// are not waited for, the module reports them missing itself
+
+		std::vector<int> ready;
+		for(int i = 0; i < pending.size(); ++i)
+			if(IsModuleReady(pending[i], pending)) ready.push_back(pending[i]);
+
+		if(ready.size() == 0) {
+			kVerbose -> Error(18);
+			ready = pending;
+		}
+
+		for(int i = 0; i < ready.size(); ++i)
+			pending.erase(std::find(pending.begin(), pending.end(), ready[i]));
+
+
+		// the modules nobody waits for go to the workers, the others run here; the
+		// skims are shared by all modules, hence they are only written by one process;
+		// with FuseModules the modules of a worker share one event loop
+
+		std::vector<int> local;
+		std::vector<int> remote;
+
+		for(int i = 0; i < ready.size(); ++i){
+			if(cModuleWorkers > 0 && cSkimSelections.Length() == 0 && !IsModuleNeeded(ready[i], pending)) remote.push_back(ready[i]);
+			else local.push_back(ready[i]);
+		}
+
+		if(cFuseModules && remote.size() > 0) kModuleWorkerQueue.push_back(remote);
+		else for(int i = 0; i < remote.size(); ++i) kModuleWorkerQueue.push_back(std::vector<int>(1, remote[i]));
+
+
+		// the workers start as far as there are free ones, the modules in this
+		// process do not wait for them
+
+		if(!StartModuleWorkers()) kVerbose -> Error(18);
+
+		for(int i = 0; i < local.size(); ++i){
+			kVerbose -> Module();
+			CallModuleByID(local[i], cFuseModules);
+		}
+
+		RunModulePasses();
+
+		for(int i = 0; i < local.size(); ++i){
+			std::vector<Label> outputs = GetModuleOutputsByID(local[i]);
+			kModuleProducts.insert(kModuleProducts.end(), outputs.begin(), outputs.end());
+		}
+
+
+		// render the new plots and publish the ones of the modules before
+
+		if(!kRenderQueue -> Flush()) kVerbose -> Error(13);
+		for(int i = 0; i < rendered.size(); ++i) PublishModuleOutput(rendered[i]);
+		rendered = local;
+
+		if(!StartModuleWorkers()) kVerbose -> Error(18);
 	}
 
+	while(kModuleWorkerQueue.size() > 0){
+		if(!WaitForModuleWorkers(cModuleWorkers - 1)) kVerbose -> Error(18);
+		if(!StartModuleWorkers()) kVerbose -> Error(18);
+	}
+
+	if(!WaitForModuleWorkers(0)) kVerbose -> Error(18);
+	if(!kRenderQueue -> Wait()) kVerbose -> Error(13);
+	for(int i = 0; i < rendered.size(); ++i) PublishModuleOutput(rendered[i]);
+
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::LoopOverEntries(void (AnalysisModules::*kernel)(float), Label sample_key, std::vector<Label> selection_keys){
+void AnalysisModules::RunModulePasses(){
 	/*
-	performs a loop over the maximum number of entries in the sample and
-	calls a specific kernel function every iteration
-	parameters: *kernel (pointer to the kernel function to be called), sample (data sample),
-	            selections (given event selections)
+	runs all declared module passes in one loop over the union of their samples
+	and event selections; every event is read, and every selection is parsed,
+	only once and then given to the kernels of all modules that use them, each
+	one filling its own output cache; the event counts, event lists and object
+	counts are filled once in the loop and copied to the modules afterwards,
+	before every module finishes its outputs
+	parameters: none
 	return: none
-	*/ 
+	*/
 
+	if(kModulePasses.size() == 0) return;
 
-	// loop over entries
-	for(kEntryIterator = 0; kEntryIterator < cSamples[sample_key] -> GetMaxEntries(); ++kEntryIterator) {
 
-		//std::cout << "loading entries " << kEntryIterator << ": ";
+	// the samples and the nominal event selections of all passes, the
+	// selections are ordered like in the loop over the selections
 
-		// get tree entry, i.e. load branches
-		kRootTree -> GetEntry(kEntryIterator);
+	std::vector<Label> sample_keys;
+	std::vector<Label> selection_keys;
+	bool entry_kernels = false;
 
-		// get event weight, PU reweight it if needed 
-		float event_weight = cSamples[sample_key] -> GetEventWeight();
-		if(cPileUpReweighting) event_weight *= PUWeight;
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		for(int i = 0; i < kModulePasses[p].samples.size(); ++i)
+			if(!Tools::FindElementInVector(sample_keys, kModulePasses[p].samples[i])) sample_keys.push_back(kModulePasses[p].samples[i]);
+		if(kModulePasses[p].event_selections.size() == 0) entry_kernels = true;
+	}
+
+	for(std::map<Label, AKROSD>::iterator i = cEventSelectionDefinitions.begin(); i != cEventSelectionDefinitions.end(); ++i){
+		for(int p = 0; p < kModulePasses.size(); ++p){
+			if(!Tools::FindElementInVector(kModulePasses[p].event_selections, i -> first)) continue;
+			selection_keys.push_back(i -> first);
+			break;
+		}
+	}
 
-		// prepare event selection
-		PrepareEventSelection();
 
-		//std::cout << "(#LM=" << kNumberOfKinematicObjects["LM"] << ", " << kNumberOfKinematicObjects["LE"]<< ", " << std::endl;
-			
-		// we reset the selection iterator to -1, since we increment it at the beginning of the loop
-		kSelectionIterator = -1;
+	// outputs of earlier runs with the same hash are read instead of computed,
+	// the loop only covers the samples and selections with outputs to compute
 
-		// loop over selections
-		for(std::map<Label, AKROSD>::iterator i = cEventSelectionDefinitions.begin(); i != cEventSelectionDefinitions.end(); ++i){
+	if(cIncrementalRuns) FindModulePassOutputs(sample_keys, selection_keys);
+
+
+	// the position of every sample and selection of the loop in the passes
+
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		ModulePass & pass = kModulePasses[p];
+
+		pass.sample_indices   .assign(sample_keys.size(), -1);
+		pass.selection_indices.assign(selection_keys.size(), -1);
+		pass.number_of_selections = 0;
+
+		for(int i = 0; i < sample_keys.size(); ++i){
+			int index = Tools::GetElementIndexInVector(pass.samples, sample_keys[i]);
+			if(index < pass.samples.size()) pass.sample_indices[i] = index;
+		}
+
+		for(int j = 0; j < selection_keys.size(); ++j)
+			if(Tools::FindElementInVector(pass.event_selections, selection_keys[j])) pass.selection_indices[j] = pass.number_of_selections++;
+
+		pass.number_of_variations = (pass.number_of_selections > 0) ? pass.event_selections.size() / pass.number_of_selections - 1 : 0;
+	}
 
-			// selection is used
-			if(Tools::FindElementInVector(selection_keys, i -> first)) {
-				++kSelectionIterator;
 
-				//Label key = "NLL";
-				bool return_value = ParseEventSelection(i -> second);
+	// the caches of the loop, the histograms stay with the passes
 
-				//std::cout << Tools::FindElementInMapByKey(kDefinedVariables, key) << ") " << std::endl;
-				//std::cout << kDefinedVariables["NLL"].size() << ") " << std::endl;
+	kModulePassSelections = selection_keys.size();
+	selection_keys        = AddKinematicVariations(selection_keys);
 
-				// parse event selection, if true we fill event list, event tree (later) and call the kernel
-				if(return_value){
-					FillEventList();
-					(this->*kernel)(event_weight);
+	kEventCountCache .assign(sample_keys.size(), std::vector<std::map<AKROSD, int> >(selection_keys.size()));
+	kEventListsCache .assign(sample_keys.size(), std::vector<TString>(selection_keys.size(), ""));
+	kObjectCountCache.assign(sample_keys.size(), std::map<Label, std::map<AKROSD, int> >());
+	kH1DCache        .clear();
+	kH2DCache        .clear();
+
+
+	// loop over samples, kernels without event selections see every entry; the
+	// loop is timed as one, labelled with the modules of all passes (e.g. 11+16)
+
+	Label modules = "";
+	for(int p = 0; p < kModulePasses.size(); ++p)
+		modules += Form((p == 0) ? "%d" : "+%d", kModulePasses[p].id);
+	kVerbose -> SetInstrumentationModule(modules);
+
+	if(kModulePassSelections == 0)
+		LoopOverSamples(&AnalysisModules::ModulePassEntryKernel, sample_keys, selection_keys);
+	else {
+		if(entry_kernels) kEntryKernel = &AnalysisModules::ModulePassEntryKernel;
+		LoopOverSamples(&AnalysisModules::ModulePassKernel, sample_keys, selection_keys);
+		kEntryKernel = 0;
+	}
+
+
+	// copy the counts and lists of the loop to the passes using them
+
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		ModulePass & pass = kModulePasses[p];
+		if(pass.number_of_selections == 0) continue;
+
+		for(int s = 0; s < sample_keys.size(); ++s){
+			int i = pass.sample_indices[s];
+			if(i == -1) continue;
+
+			pass.object_count_cache[i] = kObjectCountCache[s];
+
+			for(int u = 0; u < kModulePassSelections; ++u){
+				if(pass.selection_indices[u] == -1) continue;
+				for(int v = 0; v <= pass.number_of_variations; ++v){
+					int j = v * pass.number_of_selections + pass.selection_indices[u];
+					pass.event_count_cache[i][j] = kEventCountCache[s][v * kModulePassSelections + u];
+					pass.event_lists_cache[i][j] = kEventListsCache[s][v * kModulePassSelections + u];
 				}
 			}
 		}
 	}
+
+
+	// read the outputs of earlier runs that were not computed
+
+	if(cIncrementalRuns) ReadModulePassOutputs(sample_keys);
+
+
+	// finish the modules in the order they were declared
+
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		kVerbose -> SetInstrumentationModule(Form("%d", kModulePasses[p].id));
+		SwapModulePassCache(kModulePasses[p]);
+		kReadOutputs = kModulePasses[p].previous_outputs;
+		(this->*kModulePasses[p].finish)(kModulePasses[p].samples, kModulePasses[p].selections);
+	}
+
+	kReadOutputs.clear();
+	kModulePasses.clear();
+
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::LoopOverSamples(void (AnalysisModules::*kernel)(float), std::vector<Label> sample_keys, std::vector<Label> selection_keys){
+void AnalysisModules::FindModulePassOutputs(std::vector<Label> & sample_keys, std::vector<Label> & selection_keys){
 	/*
-	loops over all data samples in a vector, opens the respective trees, sets
-	the event weight and calls a given kernel function every iteration
-	parameters: *kernel (pointer to the kernel function to be called), samples 
-	            (vector of data samples), selections (given event selections)
+	looks up the outputs of all declared passes in the outputs of earlier runs
+	and reduces the samples and nominal selections of the loop to the ones that
+	have at least one output to compute; outputs that are covered by the loop
+	anyway are computed again, all others are marked to be read
+	parameters: sample_keys, selection_keys (of the loop)
 	return: none
 	*/
 
+	std::vector<Label> samples;
+	std::vector<Label> selections;
 
-	// loop over samples
-	for(kSampleIterator = 0; kSampleIterator < sample_keys.size(); ++kSampleIterator) {
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		ModulePass & pass = kModulePasses[p];
 
-		// open file
-		kVerbose -> Sample(sample_keys[kSampleIterator]);
-		TFile * root_file = TFile::Open(cSamples[sample_keys[kSampleIterator]] -> GetPath());
-		if(root_file == NULL) kVerbose -> ErrorAndExit();
-		
-		// open tree
-		kRootTree = (TTree *) root_file -> Get("Analysis");
-		kRootTree -> ResetBranchAddresses();
-		Base::Initialize(kRootTree);
+		pass.previous_outputs.assign(pass.samples.size(), std::vector<TString>(pass.selections.size(), ""));
 
-		// set event weight
- 		cSamples[sample_keys[kSampleIterator]] -> SetEventWeight(cLuminosity);
+		// kernels without event selections see every entry of their samples
 
-		// loop over entries
-		std::cout << "going to loop over entries" << std::endl;
-		if(selection_keys.size()>0) LoopOverEntries(kernel, sample_keys[kSampleIterator], selection_keys);
-		else                        LoopOverEntries(kernel, sample_keys[kSampleIterator]); 
+		if(pass.event_selections.size() == 0){
+			for(int i = 0; i < pass.samples.size(); ++i)
+				if(!Tools::FindElementInVector(samples, pass.samples[i])) samples.push_back(pass.samples[i]);
+			continue;
+		}
 
-		// delete the tree from the memory again
-		kRootTree -> Delete();
-		
+		LoadPreviousOutputs(pass.id);
+
+		int nominal = 0;
+		for(int j = 0; j < pass.event_selections.size(); ++j)
+			if(Tools::FindElementInMapByKey(cEventSelectionDefinitions, pass.event_selections[j])) ++nominal;
+
+		// without nominal selections nothing can be matched, the pass is computed
+
+		if(nominal == 0){
+			for(int i = 0; i < pass.samples.size(); ++i)
+				if(!Tools::FindElementInVector(samples, pass.samples[i])) samples.push_back(pass.samples[i]);
+			continue;
+		}
+
+		for(int i = 0; i < pass.samples.size(); ++i){
+			for(int j = 0; j < pass.selections.size(); ++j){
+				TString hash = GetOutputHash(pass.id, pass.samples[i], pass.selections[j]);
+				if(hash.Length() > 0 && Tools::FindElementInMapByKey(kPreviousOutputs, hash) && kPreviousOutputs[hash].size() == 1 + pass.h1d_cache[i][j].size() + pass.h2d_cache[i][j].size()) {
+					pass.previous_outputs[i][j] = hash;
+					continue;
+				}
+				if(!Tools::FindElementInVector(samples   , pass.samples[i]                    )) samples   .push_back(pass.samples[i]);
+				if(!Tools::FindElementInVector(selections, pass.event_selections[j % nominal])) selections.push_back(pass.event_selections[j % nominal]);
+			}
+		}
+	}
+
+
+	// the outputs inside of the loop are computed
+
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		ModulePass & pass = kModulePasses[p];
+		if(pass.event_selections.size() == 0) continue;
+
+		int nominal = 0;
+		for(int j = 0; j < pass.event_selections.size(); ++j)
+			if(Tools::FindElementInMapByKey(cEventSelectionDefinitions, pass.event_selections[j])) ++nominal;
+		if(nominal == 0) continue;
+
+		for(int i = 0; i < pass.samples.size(); ++i)
+			for(int j = 0; j < pass.selections.size(); ++j)
+				if(Tools::FindElementInVector(samples, pass.samples[i]) && Tools::FindElementInVector(selections, pass.event_selections[j % nominal]))
+					pass.previous_outputs[i][j] = "";
+	}
+
+
+	// keep the order of the loop
+
+	std::vector<Label> all_sample_keys    = sample_keys;
+	std::vector<Label> all_selection_keys = selection_keys;
+	sample_keys   .clear();
+	selection_keys.clear();
+
+	for(int i = 0; i < all_sample_keys.size(); ++i)
+		if(Tools::FindElementInVector(samples, all_sample_keys[i])) sample_keys.push_back(all_sample_keys[i]);
+	for(int j = 0; j < all_selection_keys.size(); ++j)
+		if(Tools::FindElementInVector(selections, all_selection_keys[j])) selection_keys.push_back(all_selection_keys[j]);
+
+}
+
+
+//____________________________________________________________________________
+TString AnalysisModules::GetOutputHash(int module_id, Label sample_key, Label selection_key){
+	/*
+	returns the hash of everything an output of a module depends on: the code
+	version, the configuration apart from samples, event selections, objects
+	and defined variables, the sample file, the event selection and the module;
+	of the objects and defined variables, only those the event selection and
+	the kernel of the module use enter, each with all definitions it uses (see
+	GetDefinitionHash); the outputs of modules using the products of other
+	modules depend on the whole configuration, all samples and event
+	selections, since it is not known which ones their inputs used
+	parameters: module_id, sample_key, selection_key
+	return: hash, "" (if the sample file cannot be found or a definition used
+	        uses a fixed object *)
+	*/
+
+
+	// the comparable configuration file is read once
+
+	if(kOutputHashKey.Length() == 0){
+
+		kOutputHashKey  = "version=" + kVersion;
+		kOutputHashKey += Form("|samples=%u", FileOperations::ComputeChecksum(Tools::ConvertTStringToStdString(kInfoFolder + kInfoFileDataSamples)));
+		kOutputHashInputKey = kOutputHashKey;
+
+		std::ifstream configuration_file(kOutputFolder + kConfigplot + "/0/" + kTemporaryFileConfiguration);
+		std::string line;
+
+		while(std::getline(configuration_file, line)){
+			if(line.size() == 0 || line[0] == 's' || line[0] == 'm') continue;
+			if(line[0] != 'e' && line[0] != 'o' && line[0] != 'd') kOutputHashKey += "|" + Tools::ConvertStdStringToTString(line);
+			kOutputHashInputKey += "|" + Tools::ConvertStdStringToTString(line);
+		}
+
+		for(std::map<Label, DataSample*>::iterator i = cSamples.begin(); i != cSamples.end(); ++i)
+			kOutputHashInputKey += "|" + GetSampleIdentity(i -> first);
+	}
+
+
+	// the nominal event selection of the output
+
+	TString sample = GetSampleIdentity(sample_key);
+	if(sample.Length() == 0) return "";
+
+	Label selection = selection_key;
+	for(int i = 0; i < kKinematicVariationNames.size(); ++i){
+		if(selection_key.EndsWith("_" + kKinematicVariationNames[i])){
+			selection = selection_key(0, selection_key.Length() - kKinematicVariationNames[i].Length() - 1);
+			break;
+		}
+	}
+
+	TString key = (GetModuleInputsByID(module_id).size() > 0) ? kOutputHashInputKey : kOutputHashKey;
+	key += Form("|module=%d|sample=%s|selection=%s", module_id, sample.Data(), selection_key.Data());
+	if(Tools::FindElementInMapByKey(cEventSelectionDefinitions, selection)) key += "=" + cEventSelectionDefinitions[selection];
+
+
+	// the objects and defined variables used, found by their names like in
+	// GetDefinitionHash
+
+	if(GetModuleInputsByID(module_id).size() == 0){
+
+		std::vector<Label> definitions = GetModuleDefinitionsByID(module_id);
+		TString uses = Tools::FindElementInMapByKey(cEventSelectionDefinitions, selection) ? cEventSelectionDefinitions[selection] : "";
+		for(int i = 0; i < definitions.size(); ++i)
+			uses += " " + definitions[i];
+
+		std::vector<Label> labels = Tools::GetVectorFromMapKeys(cObjectSelectionDefinitions);
+		std::vector<Label> variables = Tools::GetVectorFromMapKeys(cDefinedVariableDefinitions);
+		labels.insert(labels.end(), variables.begin(), variables.end());
+
+		for(int i = 0; i < labels.size(); ++i){
+			if(uses.Index(labels[i]) == -1) continue;
+			TString hash = GetDefinitionHash(labels[i], sample_key);
+			if(hash.Length() == 0) return "";
+			key += "|" + labels[i] + "=" + hash;
+		}
 	}
+
+	return Tools::HashTString(key);
+
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::DefineOutputCache(int module_id, std::vector<Label> sample_names, std::vector<Label> selection_names, std::vector<Label> h1d_names, std::vector<Label> h2d_names){
+void AnalysisModules::LoadPreviousOutputs(int module_id){
 	/*
-	reserves the memory for all caches needed in the module
-	parameters: module_id, sample_names, selection_names, h1d_names, h2d_names
+	collects the outputs of a module in all other configplots of the output
+	folder, which are listed with their hashes in outputhashes.txt next to the
+	ROOT file of the module
+	parameters: module_id
 	return: none
 	*/
 
-	TString output_folder = GetOutputFolder(module_id);
-	
+	if(Tools::FindElementInVector(kPreviousOutputModules, module_id)) return;
+	kPreviousOutputModules.push_back(module_id);
 
-	// if there are no samples and no selections given, then there
-	// is no cache needed
+	DIR * output_directory = opendir(kOutputFolder);
+	if(output_directory == NULL) return;
 
-	if(sample_names.size() == 0 || selection_names.size() == 0) return;
+	struct dirent * entry;
 
+	while((entry = readdir(output_directory)) != NULL){
 
-	// reset the full cache
+		TString configplot = entry -> d_name;
+		if(entry -> d_type != DT_DIR || configplot == "." || configplot == ".." || configplot == kConfigplot) continue;
 
-	kEventCountCache .clear();
-	kEventListsCache .clear();
-	kH1DCache        .clear();
-	kH2DCache        .clear();
-	kObjectCountCache.clear();
+		TString module_folder = kOutputFolder + configplot + "/" + Tools::ConvertIntToTString(module_id) + "/";
+		TString root_file     = module_folder + Tools::ConvertIntToTString(module_id) + ".root";
+		if(!FileOperations::ExistsFile(Tools::ConvertTStringToStdString(root_file))) continue;
 
+		std::ifstream index(module_folder + "outputhashes.txt");
+		std::string line;
 
-	// one column for every sample
+		while(std::getline(index, line)){
+			std::vector<TString> fields = Tools::ExplodeTString(Tools::ConvertStdStringToTString(line), "\t");
+			if(fields.size() < 3) continue;
 
-	kEventCountCache .resize(sample_names.size());
-	kEventListsCache .resize(sample_names.size());
-	kH1DCache        .resize(sample_names.size());
-	kH2DCache        .resize(sample_names.size());
-	kObjectCountCache.resize(sample_names.size());
+			std::vector<TString> output(1, root_file);
+			output.insert(output.end(), fields.begin() + 3, fields.end());
+			kPreviousOutputs[fields[0]] = output;
+		}
+	}
 
+	closedir(output_directory);
 
-	// loop over samples
-	for(int i = 0; i < sample_names.size(); ++i){
+}
 
-		// one column for every selection
 
-		kEventCountCache[i] .resize(selection_names.size());
-		kEventListsCache[i] .resize(selection_names.size(), "");
-		kH1DCache[i]        .resize(selection_names.size());
-		kH2DCache[i]        .resize(selection_names.size());
+//____________________________________________________________________________
+void AnalysisModules::ReadModulePassOutputs(std::vector<Label> sample_keys){
+	/*
+	reads the outputs of earlier runs that FindModulePassOutputs has marked into
+	the caches of the passes; the object counts of a sample come from the
+	earlier run as well if the sample has not been looped over
+	parameters: sample_keys (of the loop)
+	return: none
+	*/
+
+	std::map<TString, TFile*> files;
+
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		ModulePass & pass = kModulePasses[p];
+
+		for(int i = 0; i < pass.previous_outputs.size(); ++i){
+
+			bool object_counts = Tools::FindElementInVector(sample_keys, pass.samples[i]);
+
+			for(int j = 0; j < pass.previous_outputs[i].size(); ++j){
+				if(pass.previous_outputs[i][j].Length() == 0) continue;
+
+				std::vector<TString> & output = kPreviousOutputs[pass.previous_outputs[i][j]];
+				if(!Tools::FindElementInMapByKey(files, output[0])) files[output[0]] = TFile::Open(output[0]);
+
+				TFile * root_file = files[output[0]];
+				TDirectory * directory = (root_file == 0) ? 0 : root_file -> GetDirectory(pass.samples[i] + "/" + pass.selections[j]);
+				bool success = (directory != 0);
+
+				// event counts, event lists and histograms
+
+				pass.event_count_cache[i][j] = OtherInput::ReadCountsFromRootFile(directory, "evtcount");
+				pass.event_lists_cache[i][j] = OtherInput::ReadListFromRootFile(directory, "evtlist");
+
+				int h1ds = pass.h1d_cache[i][j].size();
+				for(int k = 0; k < h1ds; ++k)
+					success = pass.h1d_cache[i][j][k] -> ReadFromDirectory(directory, output[1 + k]) && success;
+				for(int k = 0; k < pass.h2d_cache[i][j].size(); ++k)
+					success = pass.h2d_cache[i][j][k] -> ReadFromDirectory(directory, output[1 + h1ds + k]) && success;
+
+				// object counts
+
+				if(!object_counts && root_file != 0){
+					TDirectory * sample_directory = root_file -> GetDirectory(pass.samples[i]);
+					if(sample_directory != 0){
+						TIter next(sample_directory -> GetListOfKeys());
+						TObject * key;
+						while((key = next()) != 0){
+							TString name = key -> GetName();
+							Label object = name(9, name.Length() - 9);
+							if(name.BeginsWith("objcount_")) pass.object_count_cache[i][object] = OtherInput::ReadCountsFromRootFile(sample_directory, name);
+						}
+					}
+					object_counts = true;
+				}
+
+				if(!success) kVerbose -> Error(22);
+			}
+		}
+	}
+
+	for(std::map<TString, TFile*>::iterator i = files.begin(); i != files.end(); ++i){
+		if(i -> second == 0) continue;
+		i -> second -> Close();
+		delete i -> second;
+	}
+
+}
+
+
+//____________________________________________________________________________
+bool AnalysisModules::IsOutputRead(int sample_index, int selection_index){
+	/*
+	checks if an output of the pass that is finished was read from an earlier
+	run, such that the finish function must not compute it once more
+	parameters: sample_index, selection_index
+	return: true (if read), false (if computed)
+	*/
+
+	if(sample_index >= kReadOutputs.size() || selection_index >= kReadOutputs[sample_index].size()) return false;
+
+	return kReadOutputs[sample_index][selection_index].Length() > 0;
+
+}
+
+
+//____________________________________________________________________________
+bool AnalysisModules::IsModuleNeeded(int module_id, std::vector<int> pending){
+	/*
+	checks if a module gives a product that one of the pending modules needs
+	parameters: module_id, pending (modules still to be run)
+	return: true (if the module is needed), false (else)
+	*/
+
+	std::vector<Label> outputs = GetModuleOutputsByID(module_id);
+
+	for(int i = 0; i < pending.size(); ++i){
+		std::vector<Label> inputs = GetModuleInputsByID(pending[i]);
+		for(int j = 0; j < inputs.size(); ++j)
+			if(Tools::FindElementInVector(outputs, inputs[j])) return true;
+	}
+
+	return false;
+
+}
+
+
+//____________________________________________________________________________
+bool AnalysisModules::IsModuleReady(int module_id, std::vector<int> pending){
+	/*
+	checks if all products a module needs exist, products that none of the
+	other pending modules gives are not waited for
+	parameters: module_id, pending (modules still to be run)
+	return: true (if the module can be run), false (else)
+	*/
+
+	std::vector<Label> inputs = GetModuleInputsByID(module_id);
+
+	for(int i = 0; i < inputs.size(); ++i){
+		if(Tools::FindElementInVector(kModuleProducts, inputs[i])) continue;
+		for(int j = 0; j < pending.size(); ++j){
+			if(pending[j] == module_id) continue;
+			if(Tools::FindElementInVector(GetModuleOutputsByID(pending[j]), inputs[i])) return false;
+		}
+	}
+
+	return true;
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::StartModuleWorker(std::vector<int> module_ids){
+	/*
+	runs a group of modules in a worker process and returns immediately; the
+	worker inherits all products of the modules before, runs the passes of the
+	group (in one event loop with FuseModules), renders the plots of its
+	modules with its own render queue and exits, leaving its log and its
+	instrumentation in a worker file; the outputs are published and the worker
+	file is merged once it is done
+	parameters: module_ids
+	return: none
+	*/
+
+	for(int i = 0; i < module_ids.size(); ++i)
+		kVerbose -> Module();
+
+	// only the forking thread exists in the worker, so no publishing thread may
+	// hold a lock while forking, and buffered output would be printed once more
+	if(!FileOperations::WaitForPublishing()) kVerbose -> Error(11);
+	std::cout.flush();
+	std::cerr.flush();
+	fflush(0);
+
+	pid_t pid = fork();
+
+	if(pid == 0) {
+		gROOT -> SetBatch(kTRUE);
+		kVerbose -> StartWorker();
+
+		// the render workers of this process are not children of the worker
+		kRenderQueue = new RenderQueue(kVerbose, kRenderQueue -> GetFormats(), kRenderQueue -> GetNumberOfWorkers());
+
+		for(int i = 0; i < module_ids.size(); ++i)
+			CallModuleByID(module_ids[i], cFuseModules);
+		RunModulePasses();
+		bool success = kRenderQueue -> Flush();
+		success = kRenderQueue -> Wait() && success;
+		success = kVerbose -> WriteWorkerFile() && success;
+		std::cout.flush();
+		_exit(success ? 0 : 1);
+	}
+
+	if(pid < 0) {
+		for(int i = 0; i < module_ids.size(); ++i)
+			CallModuleByID(module_ids[i], cFuseModules);
+		RunModulePasses();
+		if(!kRenderQueue -> Flush()) kVerbose -> Error(13);
+		if(!kRenderQueue -> Wait()) kVerbose -> Error(13);
+		for(int i = 0; i < module_ids.size(); ++i)
+			PublishModuleOutput(module_ids[i]);
+		return;
+	}
+
+	kModuleWorkers  .push_back(pid);
+	kModuleWorkerIDs.push_back(module_ids);
+
+}
+
+
+//____________________________________________________________________________
+bool AnalysisModules::StartModuleWorkers(){
+	/*
+	collects the module workers that are done and starts the queued groups of
+	modules in workers as long as fewer than ModuleWorkers are running; it
+	never waits for a worker, such that the modules of this process go on
+	parameters: none
+	return: true (if all collected workers succeeded), false (else)
+	*/
+
+	bool success = WaitForModuleWorkers(kModuleWorkers.size());
+
+	while(kModuleWorkerQueue.size() > 0 && (int) kModuleWorkers.size() < cModuleWorkers){
+		StartModuleWorker(kModuleWorkerQueue.front());
+		kModuleWorkerQueue.erase(kModuleWorkerQueue.begin());
+	}
+
+	return success;
+
+}
+
+
+//____________________________________________________________________________
+bool AnalysisModules::WaitForModuleWorkers(int workers){
+	/*
+	collects the module workers that are done, merges their log and their
+	instrumentation and publishes the outputs of their modules, and waits until at most a given number of them is running;
+	the render workers are children of this process as well, so we only wait
+	for the module workers by their process ID
+	parameters: workers (number of workers that may still be running)
+	return: true (if all collected workers succeeded), false (else)
+	*/
+
+	bool success = true;
+
+	while(true){
+
+		for(int i = kModuleWorkers.size() - 1; i >= 0; --i){
+			int status = 0;
+			pid_t pid = waitpid(kModuleWorkers[i], &status, WNOHANG);
+			if(pid == 0) continue;
+			if(pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) success = false;
+			if(!kVerbose -> ReadWorkerFile(kModuleWorkers[i])) success = false;
+			for(int j = 0; j < kModuleWorkerIDs[i].size(); ++j)
+				PublishModuleOutput(kModuleWorkerIDs[i][j]);
+			kModuleWorkers  .erase(kModuleWorkers  .begin() + i);
+			kModuleWorkerIDs.erase(kModuleWorkerIDs.begin() + i);
+		}
+
+		if((int) kModuleWorkers.size() <= workers) break;
+		usleep(100000);
+	}
+
+	return success;
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::EndLoopPhase(LoopPhase phase){
+	/*
+	marks the end of a phase of the event loop (reading, collecting, selecting,
+	filling or writing) for every entry; nothing is done here, the benchmarks
+	measure the phases with it
+	parameters: phase
+	return: none
+	*/
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::LoopOverEntries(void (AnalysisModules::*kernel)(float), Label sample_key){
+	/*
+	performs a loop over the maximum number of entries in the sample and
+	calls a specific kernel function every iteration
+	parameters: *kernel (pointer to the kernel function to be called), sample_index
+	return: none
+	*/ 
+
+	INSTRUMENT_TIMER(kVerbose, "LoopOverEntries");
+
+	// the progress reports the bytes read from the files, i.e. compressed
+	Long64_t start_bytes = TFile::GetFileBytesRead();
+
+	// loop over entries	
+	for(kEntryIterator = 0; kEntryIterator < cSamples[sample_key] -> GetMaxEntries(); ++kEntryIterator) {
+		
+		// get tree entry, i.e. load branches
+		{
+			INSTRUMENT_TIMER(kVerbose, "GetEntry");
+			kRootTree -> GetEntry(kEntryIterator);
+		}
+		INSTRUMENT_COUNT(kVerbose, "entries", 1);
+		kVerbose -> Progress(kEntryIterator + 1, TFile::GetFileBytesRead() - start_bytes);
+		EndLoopPhase(reading);
+
+		// get event weight, PU reweight it if needed and compute the weight variations
+		float event_weight = cSamples[sample_key] -> GetEventWeight();
+		if(cPileUpReweighting) event_weight *= PUWeight;
+		ComputeEventWeights(cSamples[sample_key] -> GetEventWeight(), event_weight);
+
+		// call the kernel
+		{
+			INSTRUMENT_TIMER(kVerbose, "Kernel");
+			(this->*kernel)(event_weight);
+		}
+		EndLoopPhase(filling);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::LoopOverEntries(void (AnalysisModules::*kernel)(float), Label sample_key, std::vector<Label> selection_keys){
+	/*
+	performs a loop over the maximum number of entries in the sample and
+	calls a specific kernel function every iteration
+	parameters: *kernel (pointer to the kernel function to be called), sample (data sample),
+	            selections (given event selections)
+	return: none
+	*/ 
+
+	INSTRUMENT_TIMER(kVerbose, "LoopOverEntries");
+
+	// the progress reports the bytes read from the files, i.e. compressed
+	Long64_t start_bytes = TFile::GetFileBytesRead();
+
+	// the selection keys contain one block of selections per kinematic variation
+	// (see AddKinematicVariations), the nominal block comes first
+	int selections = 0;
+	for(int i = 0; i < selection_keys.size(); ++i)
+		if(Tools::FindElementInMapByKey(cEventSelectionDefinitions, selection_keys[i])) ++selections;
+	int variations = (selections > 0) ? std::min((int) selection_keys.size() / selections - 1, (int) kKinematicVariations.size()) : 0;
+
+	// loop over entries
+	for(kEntryIterator = 0; kEntryIterator < cSamples[sample_key] -> GetMaxEntries(); ++kEntryIterator) {
+
+		//std::cout << "loading entries " << kEntryIterator << ": ";
+
+		// get tree entry, i.e. load branches
+		{
+			INSTRUMENT_TIMER(kVerbose, "GetEntry");
+			kRootTree -> GetEntry(kEntryIterator);
+		}
+		INSTRUMENT_COUNT(kVerbose, "entries", 1);
+		kVerbose -> Progress(kEntryIterator + 1, TFile::GetFileBytesRead() - start_bytes);
+		EndLoopPhase(reading);
+
+		// get event weight, PU reweight it if needed and compute the weight variations
+		float event_weight = cSamples[sample_key] -> GetEventWeight();
+		if(cPileUpReweighting) event_weight *= PUWeight;
+		ComputeEventWeights(cSamples[sample_key] -> GetEventWeight(), event_weight);
+
+		// kernels of fused modules without event selections see every entry
+		if(kEntryKernel != 0) {
+			INSTRUMENT_TIMER(kVerbose, "Kernel");
+			(this->*kEntryKernel)(event_weight);
+			EndLoopPhase(filling);
+		}
+
+		// loop over the nominal event and its kinematic variations, every variation
+		// re-evaluates the selections on the nominal event in the memory
+		for(int variation = 0; variation <= variations; ++variation){
+
+			ApplyKinematicVariation(variation);
+
+			// prepare event selection
+			PrepareEventSelection();
+			EndLoopPhase(collecting);
+
+			//std::cout << "(#LM=" << kNumberOfKinematicObjects["LM"] << ", " << kNumberOfKinematicObjects["LE"]<< ", " << std::endl;
+			
+			// we reset the selection iterator to the one before the block of the variation,
+			// since we increment it at the beginning of the loop
+			kSelectionIterator = variation * selections - 1;
+
+			// loop over selections
+			for(std::map<Label, AKROSD>::iterator i = cEventSelectionDefinitions.begin(); i != cEventSelectionDefinitions.end(); ++i){
+
+				// selection is used
+				if(Tools::FindElementInVector(selection_keys, i -> first)) {
+					++kSelectionIterator;
+
+					//Label key = "NLL";
+					bool return_value = ParseEventSelection(i -> second);
+					EndLoopPhase(selecting);
+					if(variation == 0) kSelectionResults[i -> first] = return_value;
+
+					//std::cout << Tools::FindElementInMapByKey(kDefinedVariables, key) << ") " << std::endl;
+					//std::cout << kDefinedVariables["NLL"].size() << ") " << std::endl;
+
+					// parse event selection, if true we fill event list, event tree (later) and call the kernel
+					if(return_value){
+						INSTRUMENT_COUNT(kVerbose, "selected events", 1);
+						FillEventList();
+						FillEventTree();
+						{
+							INSTRUMENT_TIMER(kVerbose, "Kernel");
+							(this->*kernel)(event_weight);
+						}
+						EndLoopPhase(filling);
+					}
+				}
+			}
+
+			// the selection bitmap is taken on the nominal event
+			if(variation == 0) FillSelectionBitmap();
+			EndLoopPhase(writing);
+		}
+		ApplyKinematicVariation(0);
+	}
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::LoopOverSamples(void (AnalysisModules::*kernel)(float), std::vector<Label> sample_keys, std::vector<Label> selection_keys){
+	/*
+	loops over all data samples in a vector, opens the respective trees, sets
+	the event weight and calls a given kernel function every iteration
+	parameters: *kernel (pointer to the kernel function to be called), samples 
+	            (vector of data samples), selections (given event selections)
+	return: none
+	*/
+
+
+	// start the progress reporting
+	Long64_t entries = 0;
+	for(int i = 0; i < sample_keys.size(); ++i)
+		entries += cSamples[sample_keys[i]] -> GetMaxEntries();
+	kVerbose -> StartModuleProgress(entries);
+
+	// one row of skims per sample, opened with the sample
+	kEventTreeCache.assign(sample_keys.size(), std::vector<TTree*>());
+
+
+	// loop over samples
+	for(kSampleIterator = 0; kSampleIterator < sample_keys.size(); ++kSampleIterator) {
+
+		// open file
+		kVerbose -> Sample(sample_keys[kSampleIterator]);
+		kVerbose -> SetInstrumentationSample(sample_keys[kSampleIterator]);
+		TFile * root_file = TFile::Open(cSamples[sample_keys[kSampleIterator]] -> GetPath());
+		if(root_file == NULL) kVerbose -> ErrorAndExit();
+		
+		// open tree
+		kRootTree = (TTree *) root_file -> Get("Analysis");
+		kRootTree -> ResetBranchAddresses();
+		Base::Initialize(kRootTree);
+
+		// set event weight, kinematic variations are not applied to data
+ 		cSamples[sample_keys[kSampleIterator]] -> SetEventWeight(cLuminosity);
+		kIsData = cSamples[sample_keys[kSampleIterator]] -> GetType() == data;
+
+		// open the skims, the derived columns and the selection bitmap of the sample
+		OpenEventTrees(sample_keys[kSampleIterator], selection_keys);
+		OpenDerivedColumns(sample_keys[kSampleIterator]);
+		OpenSelectionBitmap(sample_keys[kSampleIterator], selection_keys);
+
+		// loop over entries
+		kVerbose -> StartSampleProgress(sample_keys[kSampleIterator], cSamples[sample_keys[kSampleIterator]] -> GetMaxEntries(), selection_keys.size());
+		if(selection_keys.size()>0) LoopOverEntries(kernel, sample_keys[kSampleIterator], selection_keys);
+		else                        LoopOverEntries(kernel, sample_keys[kSampleIterator]); 
+		kVerbose -> EndSampleProgress();
+
+		// write the skims, the new derived columns and the selection bitmap of the sample
+		CloseEventTrees();
+		CloseDerivedColumns();
+		CloseSelectionBitmap();
+
+		// delete the tree from the memory again
+		kRootTree -> Delete();
+		
+	}
+
+	kVerbose -> SetInstrumentationSample("");
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::DefineOutputCache(int module_id, std::vector<Label> sample_names, std::vector<Label> selection_names, std::vector<Label> h1d_names, std::vector<Label> h2d_names){
+	/*
+	reserves the memory for all caches needed in the module
+	parameters: module_id, sample_names, selection_names, h1d_names, h2d_names
+	return: none
+	*/
+
+	TString output_folder = GetOutputFolder(module_id);
+	
+
+	// if there are no samples and no selections given, then there
+	// is no cache needed
+
+	if(sample_names.size() == 0 || selection_names.size() == 0) return;
+
+
+	// reset the full cache
+
+	kEventCountCache .clear();
+	kEventListsCache .clear();
+	kH1DCache        .clear();
+	kH2DCache        .clear();
+	kObjectCountCache.clear();
+
+
+	// one column for every sample
+
+	kEventCountCache .resize(sample_names.size());
+	kEventListsCache .resize(sample_names.size());
+	kH1DCache        .resize(sample_names.size());
+	kH2DCache        .resize(sample_names.size());
+	kObjectCountCache.resize(sample_names.size());
+
+
+	// loop over samples
+	for(int i = 0; i < sample_names.size(); ++i){
+
+		// one column for every selection
+
+		kEventCountCache[i] .resize(selection_names.size());
+		kEventListsCache[i] .resize(selection_names.size(), "");
+		kH1DCache[i]        .resize(selection_names.size());
+		kH2DCache[i]        .resize(selection_names.size());
+
+
+		// loop over selections
+		for(int j = 0; j < selection_names.size(); ++j) {
+			
+			// 1d histograms
+			if(h1d_names.size() > 0){
+				kH1DCache[i][j].resize(h1d_names.size());
+				for(int k = 0; k < h1d_names.size(); ++k){
+					kH1DCache[i][j][k] = new H1D(GetTimeDifferenceMS(), kVerbose);
+					kH1DCache[i][j][k] -> SetMajorParameters(output_folder, GetOutputName(module_id, histogram, h1d_names[k], sample_names[i], selection_names[j]));
+					kH1DCache[i][j][k] -> SetVariations(kWeightNames);
+					kH1DCache[i][j][k] -> SetReplicas(cBootstrapReplicas);
+				}
+			}
+
+			// 2d histograms
+			if(h2d_names.size() > 0){
+				kH2DCache[i][j].resize(h2d_names.size());
+				for(int k = 0; k < h2d_names.size(); ++k){
+					kH2DCache[i][j][k] = new H2D(GetTimeDifferenceMS(), kVerbose);
+					kH2DCache[i][j][k] -> SetMajorParameters(output_folder, GetOutputName(module_id, histogram, h2d_names[k], sample_names[i], selection_names[j]));
+					kH2DCache[i][j][k] -> SetVariations(kWeightNames);
+					kH2DCache[i][j][k] -> SetReplicas(cBootstrapReplicas);
+				}
+			}
+		}
+	}
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::WriteOutputCache(int module_id, std::vector<Label> sample_names, std::vector<Label> selection_names){
+	/*
+  	writes standard output for a module with samples and event selections into a
+	single ROOT file with one directory per sample and subdirectories per event
+	selection; single text files and plots in all PlotFormats are only written if
+	SeparateOutputFiles is set, otherwise the plots are only rendered as png for
+	the web index, and everything can be exported on demand from the ROOT file
+  	parameters: module_id, sample_names, selection_names
+  	return: none
+  	*/
+
+	INSTRUMENT_TIMER(kVerbose, "WriteOutputCache");
+
+	TString output_folder = GetOutputFolder(module_id);
+
+	TFile * root_file = OtherOutput::OpenRootFileToWrite(output_folder, Tools::ConvertIntToStdString(module_id));
+	if(root_file == 0) kVerbose -> Error(11);
+
+
+	// loop over samples	
+	for(int i = 0; i < sample_names.size(); ++i){
+
+		TDirectory * sample_directory = OtherOutput::GetRootDirectory(root_file, sample_names[i]);
+
+		// write object counts
+		for(std::map<Label, std::map<AKROSD, int> >::iterator k = kObjectCountCache[i].begin(); k != kObjectCountCache[i].end(); ++k){
+			TString obj_name = Tools::ConvertStdStringToTString("objcount_" + Tools::ConvertTStringToStdString(k->first));
+			OtherOutput::WriteCountsToRootFile(sample_directory, obj_name, GetOutputName(module_id, text, obj_name, sample_names[i]), k->second);
+			if(cSeparateOutputFiles) 
+				OtherOutput::WriteToTextFile(output_folder, GetOutputName(module_id, text, obj_name, sample_names[i]), Tools::PrintContentsOfMap(k->second));
+		}
+
+		// loop over event selections
+		for(int j = 0; j < selection_names.size(); ++j){
+
+			TDirectory * selection_directory = OtherOutput::GetRootDirectory(root_file, sample_names[i] + "/" + selection_names[j]);
+			
+			// write event counts and event lists
+			OtherOutput::WriteCountsToRootFile(selection_directory, "evtcount", GetOutputName(module_id, text, "evtcount", sample_names[i], selection_names[j]), kEventCountCache[i][j]);
+			OtherOutput::WriteListToRootFile(selection_directory, "evtlist", GetOutputName(module_id, list, "evtlist", sample_names[i], selection_names[j]), kEventListsCache[i][j]);
+			if(cSeparateOutputFiles) {
+				OtherOutput::WriteToTextFile(output_folder, GetOutputName(module_id, text, "evtcount", sample_names[i], selection_names[j]), Tools::PrintContentsOfMap(kEventCountCache[i][j]));
+				OtherOutput::WriteToTextFile(output_folder, GetOutputName(module_id, list, "evtlist", sample_names[i], selection_names[j]), kEventListsCache[i][j]);
+			}
+	
+			// write 1d histograms and queue them for rendering
+			for(int k = 0; k < kH1DCache[0][0].size(); ++k){
+				kH1DCache[i][j][k] -> WriteToDirectory(selection_directory);
+				kRenderQueue -> Add(kH1DCache[i][j][k]);
+			}
+			
+			// write 2d histograms and queue them for rendering
+			for(int k = 0; k < kH2DCache[0][0].size(); ++k){
+				kH2DCache[i][j][k] -> WriteToDirectory(selection_directory);
+				kRenderQueue -> Add(kH2DCache[i][j][k]);
+			}
+		}
+	}
+
+	if(root_file != 0 && !OtherOutput::CloseRootFile(root_file)) kVerbose -> Error(11);
+
+
+	// list the outputs with their hashes and the names of their histograms, such
+	// that later runs with IncrementalRuns can read them instead of computing them
+
+	TString hashes = "";
+
+	for(int i = 0; i < sample_names.size(); ++i){
+		for(int j = 0; j < selection_names.size(); ++j){
+			TString hash = GetOutputHash(module_id, sample_names[i], selection_names[j]);
+			if(hash.Length() == 0) continue;
+			hashes += hash + "\t" + sample_names[i] + "\t" + selection_names[j];
+			for(int k = 0; k < kH1DCache[i][j].size(); ++k)
+				hashes += "\t" + kH1DCache[i][j][k] -> GetName();
+			for(int k = 0; k < kH2DCache[i][j].size(); ++k)
+				hashes += "\t" + kH2DCache[i][j][k] -> GetName();
+			hashes += "\n";
+		}
+	}
+
+	OtherOutput::WriteToTextFile(output_folder, "outputhashes", hashes);
+
+
+	// write the ranked AKROSD profile of the module
+
+	if(kProfiler -> IsActive())
+		OtherOutput::WriteToTextFile(output_folder, GetOutputName(module_id, text, "akrosdprofile"), kProfiler -> PrintReport());
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::ModulePassEntryKernel(float event_weight){
+	/*
+	kernel of the fused loop for every entry, calls the kernels of all passes
+	without event selections that use the sample
+	parameters: event_weight
+	return: none
+	*/
+
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		if(kModulePasses[p].number_of_selections > 0) continue;
+		int sample = kModulePasses[p].sample_indices[kSampleIterator];
+		if(sample > -1) CallModulePassKernel(kModulePasses[p], sample, 0, event_weight);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::ModulePassKernel(float event_weight){
+	/*
+	kernel of the fused loop for every selected event, calls the kernels of all
+	passes that use the sample and the selection (in the same kinematic variation)
+	parameters: event_weight
+	return: none
+	*/
+
+	int variation = kSelectionIterator / kModulePassSelections;
+	int selection = kSelectionIterator % kModulePassSelections;
+
+	for(int p = 0; p < kModulePasses.size(); ++p){
+		ModulePass & pass = kModulePasses[p];
+		if(pass.number_of_selections == 0 || variation > pass.number_of_variations) continue;
+		if(pass.sample_indices[kSampleIterator] == -1 || pass.selection_indices[selection] == -1) continue;
+		CallModulePassKernel(pass, pass.sample_indices[kSampleIterator], variation * pass.number_of_selections + pass.selection_indices[selection], event_weight);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::CallModulePassKernel(ModulePass & pass, int sample_index, int selection_index, float event_weight){
+	/*
+	calls the kernel of a pass with its own output cache and the iterators set to
+	the sample and selection of the pass; the iterators of the loop are restored
+	afterwards
+	parameters: pass, sample_index, selection_index (in the pass), event_weight
+	return: none
+	*/
+
+	int sample_iterator    = kSampleIterator;
+	int selection_iterator = kSelectionIterator;
+
+	kSampleIterator    = sample_index;
+	kSelectionIterator = selection_index;
+
+	SwapModulePassCache(pass);
+	(this->*pass.kernel)(event_weight);
+	SwapModulePassCache(pass);
+
+	kSampleIterator    = sample_iterator;
+	kSelectionIterator = selection_iterator;
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::SwapModulePassCache(ModulePass & pass){
+	/*
+	exchanges the output cache with the one of a pass, swapping the vectors
+	does not copy any of their contents
+	parameters: pass
+	return: none
+	*/
+
+	kEventCountCache .swap(pass.event_count_cache);
+	kEventListsCache .swap(pass.event_lists_cache);
+	kH1DCache        .swap(pass.h1d_cache);
+	kH2DCache        .swap(pass.h2d_cache);
+	kObjectCountCache.swap(pass.object_count_cache);
+
+}
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR DOING PHYSICS                                          **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module11Frame(){
+	/*
+  	fills the fake ratio maps for the measurement regions
+ 	parameters: none
+ 	return: none
+ 	*/
+	
+
+	// samples, event selections, 1d histograms and 2d histograms
+	
+	std::vector<Label> h1ds;
+	std::vector<Label> h2ds;
+	std::vector<Label> samples;
+	std::vector<Label> selections;
+	std::vector<Label> slist;
+
+
+	// data samples
+
+	slist.push_back("qcdmu20.");
+	slist.push_back("dyjll10");
+	slist.push_back("dyjll50");
+	slist.push_back("wjlnu");
+
+	samples = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cSamples, slist));
+
+
+	// event selections
+	
+	selections = AddKinematicVariations(Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cEventSelectionDefinitions, "MR")));
+
+	
+	// 1d histograms
+	
+	// none
+
+	
+	// 2d histograms	
+	
+	h2ds.push_back(GetOutputContent("#LM", "LM.PT", "LM.ETA"));
+	h2ds.push_back(GetOutputContent("#TM", "TM.PT", "TM.ETA"));
+	h2ds.push_back(GetOutputContent("FR" , "TM.PT", "TM.ETA"));
+	
+
+	// Defining all outputs
+
+	DefineOutputCache(11, samples, selections, h1ds, h2ds);
+
+
+	// Set histogram binning
+	
+	double FR_bins_eta[6]     = {0., 0.5, 1., 1.5, 2., 2.5};
+	double FR_bins_pt[9]      = {10., 15., 20., 25., 30., 35., 40., 45., 50.};
+
+	for(int i = 0; i < samples.size(); ++i){
+		for(int j = 0; j < selections.size(); ++j){
+			for(int k = 0; k < h2ds.size(); ++k)
+				kH2DCache[i][j][k] -> SetBins(Tools::ConvertArrayToVector(FR_bins_pt), Tools::ConvertArrayToVector(FR_bins_eta));
+		}
+	}
+			
+
+	// Declare the loop over samples
+
+	AddModulePass(11, &AnalysisModules::Module11Kernel, &AnalysisModules::Module11Finish, samples, selections, selections);
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module11Finish(std::vector<Label> samples, std::vector<Label> selections){
+	/*
+	finishes module 11 once its loop is done, divides the histograms to fill
+	the fake ratio maps and writes them
+	parameters: samples, selections
+	return: none
+	*/
+
+
+	// Divide histograms to fill fake ratio map, the maps read from an
+	// earlier run are divided already
+
+	for(int i = 0; i < samples.size(); ++i)
+		for(int j = 0; j < selections.size(); ++j)
+			if(!IsOutputRead(i, j)) kH2DCache[i][j][2] -> Divide(kH2DCache[i][j][0]);
+
+
+	// Save fake ratio map in member variable, module 41 applies the one
+	// given by FakeRatioMap
+
+	std::vector<TString> map_keys = Tools::ExplodeTString(cFakeRatioMap, "/");
+
+	for(int i = 0; i < samples.size(); ++i)
+		for(int j = 0; j < selections.size(); ++j)
+			if(map_keys.size() == 2 && samples[i] == map_keys[0] && selections[j] == map_keys[1])
+				kMuonFakeRatioMap.SetMap(kH2DCache[i][j][2] -> GetTH2());
+
+
+	// Write histograms and outputs to disk
+
+	WriteOutputCache(11, samples, selections);
+	
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module11Kernel(float event_weight){
+	/*
+  	kernel to module 12
+  	parameters: event_weight
+  	return: none
+  	*/
+
+	
+	// variables of kinematic object "LM"
+
+	for(int i = 0; i < kNumberOfKinematicObjects["LM"]; ++i){
+		kH2DCache[kSampleIterator][kSelectionIterator][0] -> Fill(MuPt -> at(kKinematicObjects["LM"][i]), fabs(MuEta -> at(kKinematicObjects["LM"][i])), kEventWeights);
+	}
+
+
+	// variables of kinematic object "TM"
+	
+	for(int i = 0; i < kNumberOfKinematicObjects["TM"]; ++i){
+		kH2DCache[kSampleIterator][kSelectionIterator][1] -> Fill(MuPt -> at(kKinematicObjects["TM"][i]), fabs(MuEta -> at(kKinematicObjects["TM"][i])), kEventWeights);
+		kH2DCache[kSampleIterator][kSelectionIterator][2] -> Fill(MuPt -> at(kKinematicObjects["TM"][i]), fabs(MuEta -> at(kKinematicObjects["TM"][i])), kEventWeights);
+	}
+
+}
+
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module12Frame(){
+	/*
+  	fills lepton, jet and event control plots for the measurement regions
+ 	parameters: none
+ 	return: none
+ 	*/
+	
+
+	// samples, event selections, 1d histograms and 2d histograms
+	
+	std::vector<Label> h1ds;
+	std::vector<Label> h2ds;
+	std::vector<Label> samples;
+	std::vector<Label> selections;
+	std::vector<Label> slist;
+
+
+	// data samples
+
+	slist.push_back("qcdmu20.");
+	slist.push_back("dyjll10" );
+	slist.push_back("dyjll50" );
+	slist.push_back("wjlnu"   );
+	
+	samples = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cSamples, slist));
+
+
+	// event selections
+	
+	selections = AddKinematicVariations(Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cEventSelectionDefinitions, "MR")));
+
+	
+	// 1d histograms
+	
+	h1ds.push_back(GetOutputContent("#EVT", "HT"    ));
+	h1ds.push_back(GetOutputContent("#EVT", "NBJ"   ));
+	h1ds.push_back(GetOutputContent("#EVT", "NJ"    ));
+	h1ds.push_back(GetOutputContent("#EVT", "NVTX"  ));
+	h1ds.push_back(GetOutputContent("#LM" , "LM.D0" ));
+	h1ds.push_back(GetOutputContent("#LM" , "LM.ETA"));
+	h1ds.push_back(GetOutputContent("#LM" , "LM.ISO"));
+	h1ds.push_back(GetOutputContent("#LM" , "LM.PT" ));
+	h1ds.push_back(GetOutputContent("#TM" , "TM.D0" ));
+	h1ds.push_back(GetOutputContent("#TM" , "TM.ETA"));
+	h1ds.push_back(GetOutputContent("#TM" , "TM.ISO"));
+	h1ds.push_back(GetOutputContent("#TM" , "TM.PT" ));
+
+
+	// 2d histograms	
+
+	// none
+
+
+	// Defining all outputs
+
+	DefineOutputCache(12, samples, selections, h1ds, h2ds);
+
+
+	// Set histogram binning
+
+	for(int i = 0; i < samples.size(); ++i){
+		for(int j = 0; j < selections.size(); ++j){
+			kH1DCache[i][j][0]  -> SetBins(10,   0.0, 400.0);
+			kH1DCache[i][j][1]  -> SetBins( 3,   0.0,   3.0);
+			kH1DCache[i][j][2]  -> SetBins( 5,   1.0,   6.0);
+			kH1DCache[i][j][3]  -> SetBins(40,   0.0,  40.0);
+			kH1DCache[i][j][4]  -> SetBins(20,   0.0,   0.2);
+			kH1DCache[i][j][5]  -> SetBins(12,   0.0,   2.4);
+			kH1DCache[i][j][6]  -> SetBins(20,   0.0,   1.0);
+			kH1DCache[i][j][7]  -> SetBins(20,  10.0,  70.0);
+			kH1DCache[i][j][8]  -> SetBins(20,   0.0,   0.2);
+			kH1DCache[i][j][9]  -> SetBins(12,   0.0,   2.4);
+			kH1DCache[i][j][10] -> SetBins(20,   0.0,   1.0);
+			kH1DCache[i][j][11] -> SetBins(20,  10.0,  70.0);
+		}
+	}
+			
+
+	// Declare the loop over samples
+
+	AddModulePass(12, &AnalysisModules::Module12Kernel, &AnalysisModules::Module12Finish, samples, selections, selections);
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module12Finish(std::vector<Label> samples, std::vector<Label> selections){
+	/*
+	finishes module 12 once its loop is done
+	parameters: samples, selections
+	return: none
+	*/
+
+
+	// Write histograms and outputs to disk
+
+	WriteOutputCache(12, samples, selections);
+	
+
+	// Save fake ratio map in member variable
+
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module12Kernel(float event_weight){
+	/*
+  	kernel to module 12
+  	parameters: event_weight
+  	return: none
+  	*/
+	
+
+	// event variables
+
+	//kH1DCache[kSampleIterator][kSelectionIterator][0] -> Fill(kDefinedVariables["HT"][0]     , kEventWeights);
+	kH1DCache[kSampleIterator][kSelectionIterator][1] -> Fill(kNumberOfKinematicObjects["GJ"], kEventWeights);
+	kH1DCache[kSampleIterator][kSelectionIterator][2] -> Fill(kNumberOfKinematicObjects["BJ"], kEventWeights);
+	kH1DCache[kSampleIterator][kSelectionIterator][3] -> Fill((NVrtx>40)?40:NVrtx            , kEventWeights);
+
+
+	// variables of kinematic object "LM"
+
+	for(int i = 0; i < kNumberOfKinematicObjects["LM"]; ++i){
+		kH1DCache[kSampleIterator][kSelectionIterator][4] -> Fill(MuD0    -> at(kKinematicObjects["LM"][i]), kEventWeights);
+		kH1DCache[kSampleIterator][kSelectionIterator][5] -> Fill(MuEta   -> at(kKinematicObjects["LM"][i]), kEventWeights);
+		kH1DCache[kSampleIterator][kSelectionIterator][6] -> Fill(MuPFIso -> at(kKinematicObjects["LM"][i]), kEventWeights);
+		kH1DCache[kSampleIterator][kSelectionIterator][7] -> Fill(MuPt    -> at(kKinematicObjects["LM"][i]), kEventWeights);
+	}
+
+
+	// variables of kinematic object "TM"
+
+	for(int i = 0; i < kNumberOfKinematicObjects["TM"]; ++i){
+		kH1DCache[kSampleIterator][kSelectionIterator][8]  -> Fill(MuD0    -> at(kKinematicObjects["TM"][i]), kEventWeights);
+		kH1DCache[kSampleIterator][kSelectionIterator][9]  -> Fill(MuEta   -> at(kKinematicObjects["TM"][i]), kEventWeights);
+		kH1DCache[kSampleIterator][kSelectionIterator][10] -> Fill(MuPFIso -> at(kKinematicObjects["TM"][i]), kEventWeights);
+		kH1DCache[kSampleIterator][kSelectionIterator][11] -> Fill(MuPt    -> at(kKinematicObjects["TM"][i]), kEventWeights);
+	}
+
+
+	// variables of kinematic object "GJ"
+
+	//for(int i = 0; i < kNumberOfKinematicObjects["GJ"]; ++i){
+	//	kH1DCache[kSampleIterator][kSelectionIterator][8]  -> Fill(JetD0    -> at(kKinematicObjects["TM"][i]), kEventWeights);
+	//	kH1DCache[kSampleIterator][kSelectionIterator][9]  -> Fill(JetEta   -> at(kKinematicObjects["TM"][i]), kEventWeights);
+	//	kH1DCache[kSampleIterator][kSelectionIterator][10] -> Fill(JetPFIso -> at(kKinematicObjects["TM"][i]), kEventWeights);
+	//	kH1DCache[kSampleIterator][kSelectionIterator][11] -> Fill(JetPt    -> at(kKinematicObjects["TM"][i]), kEventWeights);
+	//}
+
+
+
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module13Frame(){
+
+	std::vector<Label> samples;
+	std::vector<Label> h1d;
+	std::vector<Label> h2d;
+
+	samples.push_back("qcdmu20.");
+
+	std::vector<Label> sample_names    = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByObjectNames(cSamples, samples));
+	std::vector<Label> selection_names;
+
+	LoopOverSamples(&AnalysisModules::Module13Kernel, sample_names, selection_names);
+
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module13Kernel(float event_weight){
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module16Frame(){
+	/*
+	fills the fake ratio maps of the muon measurement region for several away-jet
+	pt thresholds at once; the region is selected directly on the tree, such that
+	the lepton selection and the jet cleaning are done once per event and every
+	threshold only costs a comparison and the filling of its histograms
+ 	parameters: none
+ 	return: none
+ 	*/
+
+
+	// samples, jet thresholds, 1d histograms and 2d histograms
+
+	std::vector<Label> h1ds;
+	std::vector<Label> h2ds;
+	std::vector<Label> samples;
+	std::vector<Label> selections;
+	std::vector<Label> slist;
+
+
+	// data samples, the trigger is only required on data
+
+	slist.push_back("qcdmu20.");
+	slist.push_back("dyjll10");
+	slist.push_back("dyjll50");
+	slist.push_back("wjlnu");
+
+	samples = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cSamples, slist));
+
+	kFakeRatioTrigger.clear();
+	for(int i = 0; i < samples.size(); ++i)
+		kFakeRatioTrigger.push_back(cSamples[samples[i]] -> GetType() == data);
+
+
+	// away-jet pt thresholds in ascending order, one output directory each
+
+	float jet_thresholds[4] = {30., 40., 50., 60.};
+
+	kFakeRatioJetThresholds = Tools::ConvertArrayToVector(jet_thresholds);
+	for(int i = 0; i < kFakeRatioJetThresholds.size(); ++i)
+		selections.push_back("AJ" + Tools::ConvertIntToTString((int) kFakeRatioJetThresholds[i]));
+
+
+	// 1d histograms
+
+	// none
+
+
+	// 2d histograms
+
+	h2ds.push_back(GetOutputContent("#LM", "LM.PT", "LM.ETA"));
+	h2ds.push_back(GetOutputContent("#TM", "TM.PT", "TM.ETA"));
+	h2ds.push_back(GetOutputContent("FR" , "TM.PT", "TM.ETA"));
+
+
+	// Defining all outputs
+
+	DefineOutputCache(16, samples, selections, h1ds, h2ds);
+
+
+	// Set histogram binning
+
+	double FR_bins_eta[6]     = {0., 0.5, 1., 1.5, 2., 2.5};
+	double FR_bins_pt[9]      = {10., 15., 20., 25., 30., 35., 40., 45., 50.};
+
+	for(int i = 0; i < samples.size(); ++i){
+		for(int j = 0; j < selections.size(); ++j){
+			for(int k = 0; k < h2ds.size(); ++k)
+				kH2DCache[i][j][k] -> SetBins(Tools::ConvertArrayToVector(FR_bins_pt), Tools::ConvertArrayToVector(FR_bins_eta));
+		}
+	}
+
+
+	// Declare the loop over samples, without event selections the kernel sees
+	// every event
+
+	AddModulePass(16, &AnalysisModules::Module16Kernel, &AnalysisModules::Module16Finish, samples, selections, std::vector<Label>());
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module16Finish(std::vector<Label> samples, std::vector<Label> selections){
+	/*
+	finishes module 16 once its loop is done, divides the histograms to fill
+	the fake ratio maps and writes them
+	parameters: samples, selections
+	return: none
+	*/
+
+
+	// Divide histograms to fill fake ratio map, the maps read from an
+	// earlier run are divided already
+
+	for(int i = 0; i < samples.size(); ++i)
+		for(int j = 0; j < selections.size(); ++j)
+			if(!IsOutputRead(i, j)) kH2DCache[i][j][2] -> Divide(kH2DCache[i][j][0]);
+
+
+	// Write histograms and outputs to disk
+
+	WriteOutputCache(16, samples, selections);
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module16Kernel(float event_weight){
+	/*
+  	kernel to module 16, selects events with exactly one loose muon, no further
+	loose leptons, small MET and MT and an away jet; the leading away jet decides
+	which thresholds the event passes, since the thresholds are sorted we stop at
+	the first one it fails
+  	parameters: event_weight
+  	return: none
+  	*/
+
+
+	// trigger
+
+	if(kFakeRatioTrigger[kSampleIterator] && !HLT_MU17) return;
+
+
+	// loose leptons above 10 GeV, exactly one loose muon above 20 GeV and
+	// no further loose lepton are allowed
+
+	std::vector<float> loose_eta;
+	std::vector<float> loose_phi;
+	int lep    = -1;
+	int nveto  =  0;
+
+	for(int i = 0; i < MuPt -> size(); ++i){
+		if(MuPt -> at(i) < 10. || !MuIsLoose -> at(i)) continue;
+		loose_eta.push_back(MuEta -> at(i));
+		loose_phi.push_back(MuPhi -> at(i));
+		if(MuPt -> at(i) > 20. && lep == -1) lep = i;
+		else                                 ++nveto;
+	}
+
+	for(int i = 0; i < ElPt -> size(); ++i){
+		if(ElPt -> at(i) < 10. || !ElIsLoose -> at(i) || ElPFIso -> at(i) > 0.6) continue;
+		loose_eta.push_back(ElEta -> at(i));
+		loose_phi.push_back(ElPhi -> at(i));
+		++nveto;
+	}
+
+	if(lep == -1 || nveto > 0) return;
+
+
+	// upper MET and MT cuts
+
+	float met    = GetMET();
+	float metphi = GetMETPhi();
+
+	if(met > 20.) return;
+	if(sqrt(2 * met * MuPt -> at(lep) * (1. - cos(AnalysisTools::DeltaPhi(metphi, MuPhi -> at(lep))))) > 20.) return;
+
+
+	// jet cleaning, the closest jet to every loose lepton is removed if it is
+	// closer than 0.4
+
+	FillJetCleaningTable(loose_eta, loose_phi, 0.4);
+
+
+	// leading away jet, i.e. a clean central jet with DR > 1 to the muon
+
+	float leading_pt = -1.;
+
+	for(int j = 0; j < JetPt -> size(); ++j){
+		if(!kCleanJets[j] || fabs(JetEta -> at(j)) > 2.5) continue;
+		if(AnalysisTools::DeltaR(JetEta -> at(j), MuEta -> at(lep), JetPhi -> at(j), MuPhi -> at(lep)) < 1.0) continue;
+		if(GetJetPt(j) > leading_pt) leading_pt = GetJetPt(j);
+	}
+
+
+	// fill the maps of every threshold the leading away jet passes
+
+	float pt    = MuPt -> at(lep);
+	float eta   = fabs(MuEta -> at(lep));
+	bool  tight = MuIsTight -> at(lep);
+
+	for(int i = 0; i < kFakeRatioJetThresholds.size() && leading_pt >= kFakeRatioJetThresholds[i]; ++i){
+		kH2DCache[kSampleIterator][i][0] -> Fill(pt, eta, kEventWeights);
+		if(!tight) continue;
+		kH2DCache[kSampleIterator][i][1] -> Fill(pt, eta, kEventWeights);
+		kH2DCache[kSampleIterator][i][2] -> Fill(pt, eta, kEventWeights);
+	}
+
+}
+
+
+
+
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module36Frame(){
+	/*
+	scans the boundaries of the signal regions in a single loop; every event of
+	the baseline selections (ScanSelections) fills one cell of a grid over the
+	scanned variables (ScanVariables), which is kept as a histogram with one bin
+	per cell, such that kinematic variations, bootstrap replicas and incremental
+	runs work as for every other histogram; the yields of the regions are taken
+	from the grid once the loop is done
+ 	parameters: none
+ 	return: none
+ 	*/
+
+
+	// scanned variables, baseline selections and regions
+
+	std::vector<Label> baselines;
+	std::vector<TString> regions;
+
+	if(cScanSelections.Length() > 0) baselines = Tools::ExplodeTString(cScanSelections, ",");
+	if(cScanRegions   .Length() > 0) regions   = Tools::ExplodeTString(cScanRegions   , ";");
+
+	bool legal = kCutScan.SetVariables(cScanVariables) && baselines.size() > 0;
+
+	for(int i = 0; i < baselines.size(); ++i)
+		if(!Tools::FindElementInMapByKey(cEventSelectionDefinitions, baselines[i])) legal = false;
+
+	float yield, error;
+	for(int i = 0; i < regions.size(); ++i)
+		if(legal && !kCutScan.GetYield(regions[i], yield, error)) legal = false;
+
+	if(!legal) {
+		kVerbose -> Error(23);
+		return;
+	}
+
+	kCutScanValues.resize(kCutScan.GetNumberOfVariables());
+
+
+	// samples, event selections, 1d histograms and 2d histograms
+
+	std::vector<Label> h1ds;
+	std::vector<Label> h2ds;
+	std::vector<Label> samples;
+	std::vector<Label> selections;
+
+
+	// data samples
+
+	samples = Tools::GetVectorFromMapKeys(cSamples);
+
+
+	// event selections
+
+	selections = AddKinematicVariations(baselines);
+
+
+	// 1d histograms
+
+	h1ds.push_back(GetOutputContent("NEVT", "SCAN"));
+
+
+	// 2d histograms
+
+	// none
+
+
+	// Defining all outputs
+
+	DefineOutputCache(36, samples, selections, h1ds, h2ds);
+
+
+	// Set histogram binning
+
+	for(int i = 0; i < samples.size(); ++i)
+		for(int j = 0; j < selections.size(); ++j)
+			kH1DCache[i][j][0] -> SetBins(kCutScan.GetNumberOfBins(), 0.0, (float) kCutScan.GetNumberOfBins());
+
+
+	// Declare the loop over samples
+
+	AddModulePass(36, &AnalysisModules::Module36Kernel, &AnalysisModules::Module36Finish, samples, selections, selections);
+
+}
+
+
+//____________________________________________________________________________
+void AnalysisModules::Module36Finish(std::vector<Label> samples, std::vector<Label> selections){
+	/*
+	finishes module 36 once its loop is done; the grid of every sample and
+	selection is accumulated and the yields of the regions in ScanRegions and of
+	all region sets (every subset of the thresholds) are written to a text file,
+	one line per region or region set
+	parameters: samples, selections
+	return: none
+	*/
+
+
+	// Write histograms and outputs to disk
+
+	WriteOutputCache(36, samples, selections);
+
+
+	// yields of the regions and region sets
+
+	TString output_folder = GetOutputFolder(36);
+
+	std::vector<TString> regions;
+	if(cScanRegions.Length() > 0) regions = Tools::ExplodeTString(cScanRegions, ";");
+
+	std::vector<double> sums   (kCutScan.GetNumberOfBins());
+	std::vector<double> squares(kCutScan.GetNumberOfBins());
+	std::vector<float> yields;
+	std::vector<float> errors;
+
+	for(int i = 0; i < samples.size(); ++i){
+		for(int j = 0; j < selections.size(); ++j){
+
+			TH1F * grid = kH1DCache[i][j][0] -> GetTH1();
+			for(int b = 0; b < sums.size(); ++b){
+				sums   [b] = grid -> GetBinContent(b + 1);
+				squares[b] = grid -> GetBinError(b + 1) * grid -> GetBinError(b + 1);
+			}
+			kCutScan.SetContents(sums, squares);
 
+			TString scan = "# region\tyield\terror\n";
 
-		// loop over selections
-		for(int j = 0; j < selection_names.size(); ++j) {
-			
-			// 1d histograms
-			if(h1d_names.size() > 0){
-				kH1DCache[i][j].resize(h1d_names.size());
-				for(int k = 0; k < h1d_names.size(); ++k){
-					kH1DCache[i][j][k] = new H1D(GetTimeDifferenceMS(), kVerbose);
-					kH1DCache[i][j][k] -> SetMajorParameters(output_folder, GetOutputName(module_id, histogram, h1d_names[k], sample_names[i], selection_names[j]));
-				}
+			float yield, error;
+			for(int r = 0; r < regions.size(); ++r){
+				kCutScan.GetYield(regions[r], yield, error);
+				scan += regions[r] + Form("\t%g\t%g\n", yield, error);
 			}
 
-			// 2d histograms
-			if(h2d_names.size() > 0){
-				kH2DCache[i][j].resize(h2d_names.size());
-				for(int k = 0; k < h2d_names.size(); ++k){
-					kH2DCache[i][j][k] = new H2D(GetTimeDifferenceMS(), kVerbose);
-					kH2DCache[i][j][k] -> SetMajorParameters(output_folder, GetOutputName(module_id, histogram, h2d_names[k], sample_names[i], selection_names[j]));
+			scan += "# region set\tyields\terrors (of its regions, the ones of the first variable run fastest)\n";
+
+			for(int s = 0; s < kCutScan.GetNumberOfRegionSets(); ++s){
+				kCutScan.GetRegionSetYields(s, yields, errors);
+				TString yield_list = "";
+				TString error_list = "";
+				for(int r = 0; r < yields.size(); ++r){
+					yield_list += Form(r == 0 ? "%g" : ",%g", yields[r]);
+					error_list += Form(r == 0 ? "%g" : ",%g", errors[r]);
 				}
+				scan += kCutScan.GetRegionSet(s) + "\t" + yield_list + "\t" + error_list + "\n";
 			}
+
+			OtherOutput::WriteToTextFile(output_folder, GetOutputName(36, text, "scan", samples[i], selections[j]), scan);
 		}
 	}
+
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::WriteOutputCache(int module_id, std::vector<Label> sample_names, std::vector<Label> selection_names){
+void AnalysisModules::Module36Kernel(float event_weight){
 	/*
-  	writes standard output for a module with samples and event selections
-  	parameters: module_id, sample_names, selection_names
+  	kernel to module 36, evaluates the scanned variables and fills the cell of
+	the grid the event is in
+  	parameters: event_weight
   	return: none
   	*/
 
-	TString output_folder = GetOutputFolder(module_id);
-
-
-	// loop over samples	
-	for(int i = 0; i < sample_names.size(); ++i){
-
-		// write object counts
-		for(std::map<Label, std::map<AKROSD, int> >::iterator k = kObjectCountCache[i].begin(); k != kObjectCountCache[i].end(); ++k){
-			TString obj_name = Tools::ConvertStdStringToTString("objcount_" + Tools::ConvertTStringToStdString(k->first));
-			OtherOutput::WriteToTextFile(output_folder, GetOutputName(module_id, text, obj_name, sample_names[i]), Tools::PrintContentsOfMap(k->second));
-		}
+	for(int d = 0; d < kCutScanValues.size(); ++d)
+		kCutScanValues[d] = ParseAKROSDVariable(kCutScan.GetVariable(d));
 
-		// loop over event selections
-		for(int j = 0; j < selection_names.size(); ++j){
-			
-			// write event counts and event lists
-			OtherOutput::WriteToTextFile(output_folder, GetOutputName(module_id, text, "evtcount", sample_names[i], selection_names[j]), Tools::PrintContentsOfMap(kEventCountCache[i][j]));
-			OtherOutput::WriteToTextFile(output_folder, GetOutputName(module_id, list, "evtlist", sample_names[i], selection_names[j]), kEventListsCache[i][j]);
-	
-			// write 1d histograms
-			for(int k = 0; k < kH1DCache[0][0].size(); ++k)
-				kH1DCache[i][j][k] -> Write(kCanvas);
-			
-			// write 2d histograms
-			for(int k = 0; k < kH2DCache[0][0].size(); ++k){
-				kCanvas -> ls();
-				kH2DCache[i][j][k] -> Write(kCanvas);
-			}
-		}
+	kH1DCache[kSampleIterator][kSelectionIterator][0] -> Fill(kCutScan.GetBin(kCutScanValues) + 0.5, kEventWeights);
 
-		// print all H1D and H2D histograms in a single root file
-	}
 }
 
 
 
-/*****************************************************************************
-******************************************************************************
-** CLASS MEMBERS FOR DOING PHYSICS                                          **
-******************************************************************************
-*****************************************************************************/
+
 
 
 //____________________________________________________________________________
-void AnalysisModules::Module11Frame(){
+void AnalysisModules::Module41Frame(){
 	/*
-  	fills the fake ratio maps for the measurement regions
+	estimates the number of events with fake leptons in the signal regions by
+	applying the fake ratio map of module 11 to the two leading loose leptons;
+	every event contributes to all predictions at once, the categories of the
+	histogram are
+	  0: events with two tight leptons (observed)
+	  1: prompt-prompt prediction
+	  2: prompt-fake prediction
+	  3: fake-fake prediction
  	parameters: none
  	return: none
  	*/
-	
+
+
+	// the fake ratio map needs to be measured by module 11 first, whose pass
+	// may still be waiting to be run
+
+	if(kMuonFakeRatioMap.IsEmpty()) RunModulePasses();
+	if(kMuonFakeRatioMap.IsEmpty()) {
+		kVerbose -> Error(17);
+		return;
+	}
+
+	// module 11 only measures the map of the muons so far
+	if(kElectronFakeRatioMap.IsEmpty()) kVerbose -> Error(26);
+
 
 	// samples, event selections, 1d histograms and 2d histograms
-	
+
 	std::vector<Label> h1ds;
 	std::vector<Label> h2ds;
 	std::vector<Label> samples;
 	std::vector<Label> selections;
-	std::vector<Label> slist;
 
 
 	// data samples
 
-	slist.push_back("qcdmu20.");
-	slist.push_back("dyjll10");
-	slist.push_back("dyjll50");
-	slist.push_back("wjlnu");
-
-	samples = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cSamples, slist));
+	samples = Tools::GetVectorFromMapKeys(cSamples);
 
 
 	// event selections
-	
-	selections = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cEventSelectionDefinitions, "MR"));
 
-	
+	selections = AddKinematicVariations(Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cEventSelectionDefinitions, "SR")));
+
+
 	// 1d histograms
-	
+
+	h1ds.push_back(GetOutputContent("NEVT", "CAT"));
+
+
+	// 2d histograms
+
 	// none
 
-	
-	// 2d histograms	
-	
-	h2ds.push_back(GetOutputContent("#LM", "LM.PT", "LM.ETA"));
-	h2ds.push_back(GetOutputContent("#TM", "TM.PT", "TM.ETA"));
-	h2ds.push_back(GetOutputContent("FR" , "TM.PT", "TM.ETA"));
-	
 
 	// Defining all outputs
 
-	DefineOutputCache(11, samples, selections, h1ds, h2ds);
+	DefineOutputCache(41, samples, selections, h1ds, h2ds);
 
 
 	// Set histogram binning
-	
-	double FR_bins_eta[6]     = {0., 0.5, 1., 1.5, 2., 2.5};
-	double FR_bins_pt[9]      = {10., 15., 20., 25., 30., 35., 40., 45., 50.};
-
-	for(int i = 0; i < samples.size(); ++i){
-		for(int j = 0; j < selections.size(); ++j){
-			for(int k = 0; k < h2ds.size(); ++k)
-				kH2DCache[i][j][k] -> SetBins(Tools::ConvertArrayToVector(FR_bins_pt), Tools::ConvertArrayToVector(FR_bins_eta));
-		}
-	}
-			
 
-	// Loop over samples
+	for(int i = 0; i < samples.size(); ++i)
+		for(int j = 0; j < selections.size(); ++j)
+			kH1DCache[i][j][0] -> SetBins(4, 0.0, 4.0);
 
-	LoopOverSamples(&AnalysisModules::Module11Kernel, samples, selections);
 
+	// Declare the loop over samples
 
-	// Divide histograms to fill fake ratio map
+	AddModulePass(41, &AnalysisModules::Module41Kernel, &AnalysisModules::Module41Finish, samples, selections, selections);
 
-	for(int i = 0; i < samples.size(); ++i)
-		for(int j = 0; j < selections.size(); ++j)
-			kH2DCache[i][j][2] -> Divide(kH2DCache[i][j][0]);
+}
 
 
-	// Write histograms and outputs to disk
+//____________________________________________________________________________
+void AnalysisModules::Module41Finish(std::vector<Label> samples, std::vector<Label> selections){
+	/*
+	finishes module 41 once its loop is done
+	parameters: samples, selections
+	return: none
+	*/
 
-	WriteOutputCache(11, samples, selections);
 
+	// Write histograms and outputs to disk
 
-	// Save fake ratio map in member variable
+	WriteOutputCache(41, samples, selections);
 
-	
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::Module11Kernel(float event_weight){
+void AnalysisModules::Module41Kernel(float event_weight){
 	/*
-  	kernel to module 12
+  	kernel to module 41, takes the two leading loose leptons of the event and
+	fills the tight-to-loose predictions; with w = f/(1-f) per loose-not-tight
+	lepton, one of them enters the prompt-fake prediction with w and two of
+	them the fake-fake prediction with w1*w2, which is subtracted twice from the
+	prompt-fake prediction; the prompt-prompt prediction is the observed number
+	minus both
   	parameters: event_weight
   	return: none
   	*/
 
-	
-	// variables of kinematic object "LM"
 
-	for(int i = 0; i < kNumberOfKinematicObjects["LM"]; ++i){
-		kH2DCache[kSampleIterator][kSelectionIterator][0] -> Fill(MuPt -> at(kKinematicObjects["LM"][i]), MuEta -> at(kKinematicObjects["LM"][i]), event_weight);
+	// the two leading loose leptons, muons and electrons use their own map
+
+	float pt[2]               = {-1., -1.};
+	float eta[2]              = {0., 0.};
+	bool tight[2]             = {false, false};
+	int lepton[2]             = {-1, -1};
+	int flavor[2]             = {-1, -1};
+	FakeRatioMap * map[2]     = {0, 0};
+
+	Label objects[2]          = {"LM", "LE"};
+	FakeRatioMap * maps[2]    = {&kMuonFakeRatioMap, &kElectronFakeRatioMap};
+
+	for(int f = 0; f < 2; ++f){
+		for(int i = 0; i < kNumberOfKinematicObjects[objects[f]]; ++i){
+			int index    = kKinematicObjects[objects[f]][i];
+			float lep_pt = (f == 0) ? MuPt -> at(index) : ElPt -> at(index);
+			if(lep_pt <= pt[1]) continue;
+
+			int k = (lep_pt > pt[0]) ? 0 : 1;
+			if(k == 0) {
+				pt[1]     = pt[0];
+				eta[1]    = eta[0];
+				tight[1]  = tight[0];
+				lepton[1] = lepton[0];
+				flavor[1] = flavor[0];
+				map[1]    = map[0];
+			}
+			pt[k]     = lep_pt;
+			eta[k]    = (f == 0) ? MuEta -> at(index)     : ElEta -> at(index);
+			tight[k]  = (f == 0) ? MuIsTight -> at(index) : ElIsTight -> at(index);
+			lepton[k] = index;
+			flavor[k] = f;
+			map[k]    = maps[f];
+		}
 	}
 
+	if(map[1] == 0) return;
 
-	// variables of kinematic object "TM"
-	
-	for(int i = 0; i < kNumberOfKinematicObjects["TM"]; ++i){
-		kH2DCache[kSampleIterator][kSelectionIterator][1] -> Fill(MuPt -> at(kKinematicObjects["TM"][i]), MuEta -> at(kKinematicObjects["TM"][i]), event_weight);
-		kH2DCache[kSampleIterator][kSelectionIterator][2] -> Fill(MuPt -> at(kKinematicObjects["TM"][i]), MuEta -> at(kKinematicObjects["TM"][i]), event_weight);
+
+	// weights of the loose-not-tight leptons
+
+	float weight[2];
+	for(int k = 0; k < 2; ++k)
+		weight[k] = tight[k] ? 0. : map[k] -> GetWeight(pt[k], eta[k]);
+
+
+	// tight-tight, tight-loose and loose-loose events
+
+	if(tight[0] && tight[1]) {
+		FillFakePrediction(0, 1.);
+		FillFakePrediction(1, 1.);
+	}
+	else if(tight[0] || tight[1]) {
+		FillFakePrediction(2,  weight[0] + weight[1]);
+		FillFakePrediction(1, -weight[0] - weight[1]);
+	}
+	else {
+		FillFakePrediction(3,       weight[0] * weight[1]);
+		FillFakePrediction(2, -2. * weight[0] * weight[1]);
+		FillFakePrediction(1,       weight[0] * weight[1]);
 	}
 
-}
 
+	// in the closure test, the observed events are split by the number of
+	// leptons that are not prompt in the simulation
+
+	if(kClosureTest && tight[0] && tight[1]) {
+		int fakes = 0;
+		for(int k = 0; k < 2; ++k){
+			bool prompt;
+			if(flavor[k] == 0) prompt = MuIsPrompt -> at(lepton[k]) || AnalysisTools::GetLeptonOrigin(MuMID -> at(lepton[k]), MuGMID -> at(lepton[k])) == 1;
+			else               prompt = ElIsPrompt -> at(lepton[k]) || AnalysisTools::GetLeptonOrigin(ElMID -> at(lepton[k]), ElGMID -> at(lepton[k])) == 1;
+			if(!prompt) ++fakes;
+		}
+		kH1DCache[kSampleIterator][kSelectionIterator][1] -> Fill(0.5,         kEventWeights);
+		kH1DCache[kSampleIterator][kSelectionIterator][1] -> Fill(fakes + 1.5, kEventWeights);
+	}
+
+}
 
 
 //____________________________________________________________________________
-void AnalysisModules::Module12Frame(){
+void AnalysisModules::Module42Frame(){
 	/*
-  	fills lepton, jet and event control plots for the measurement regions
+	tests the closure of the estimation of module 41 on the simulation; the
+	prediction and the truth-matched observation are filled in the same event
+	loop, such that both see identical events, and their ratio is written per
+	category
  	parameters: none
  	return: none
  	*/
-	
+
+
+	// the fake ratio map needs to be measured by module 11 first, whose pass
+	// may still be waiting to be run
+
+	if(kMuonFakeRatioMap.IsEmpty()) RunModulePasses();
+	if(kMuonFakeRatioMap.IsEmpty()) {
+		kVerbose -> Error(17);
+		return;
+	}
+
+	// module 11 only measures the map of the muons so far
+	if(kElectronFakeRatioMap.IsEmpty()) kVerbose -> Error(26);
+
 
 	// samples, event selections, 1d histograms and 2d histograms
-	
+
 	std::vector<Label> h1ds;
 	std::vector<Label> h2ds;
 	std::vector<Label> samples;
 	std::vector<Label> selections;
-	std::vector<Label> slist;
 
 
-	// data samples
+	// simulated samples only
 
-	slist.push_back("qcdmu20.");
-	slist.push_back("dyjll10" );
-	slist.push_back("dyjll50" );
-	slist.push_back("wjlnu"   );
-	
-	samples = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cSamples, slist));
+	for(std::map<Label, DataSample*>::iterator i = cSamples.begin(); i != cSamples.end(); ++i)
+		if(i -> second -> GetType() == mc) samples.push_back(i -> first);
 
 
 	// event selections
-	
-	selections = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cEventSelectionDefinitions, "MR"));
-
-	
-	// 1d histograms
-	
-	h1ds.push_back(GetOutputContent("#EVT", "HT"    ));
-	h1ds.push_back(GetOutputContent("#EVT", "NBJ"   ));
-	h1ds.push_back(GetOutputContent("#EVT", "NJ"    ));
-	h1ds.push_back(GetOutputContent("#EVT", "NVTX"  ));
-	h1ds.push_back(GetOutputContent("#LM" , "LM.D0" ));
-	h1ds.push_back(GetOutputContent("#LM" , "LM.ETA"));
-	h1ds.push_back(GetOutputContent("#LM" , "LM.ISO"));
-	h1ds.push_back(GetOutputContent("#LM" , "LM.PT" ));
-	h1ds.push_back(GetOutputContent("#TM" , "TM.D0" ));
-	h1ds.push_back(GetOutputContent("#TM" , "TM.ETA"));
-	h1ds.push_back(GetOutputContent("#TM" , "TM.ISO"));
-	h1ds.push_back(GetOutputContent("#TM" , "TM.PT" ));
 
+	selections = AddKinematicVariations(Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByKeys(cEventSelectionDefinitions, "SR")));
 
-	// 2d histograms	
 
-	// none
+	// 1d histograms, the categories are the ones of module 41
 
+	h1ds.push_back(GetOutputContent("NEVT" , "CAT"));
+	h1ds.push_back(GetOutputContent("TRUTH", "CAT"));
+	h1ds.push_back(GetOutputContent("CLOS" , "CAT"));
 
-	// Defining all outputs
 
-	DefineOutputCache(12, samples, selections, h1ds, h2ds);
+	// 2d histograms
 
+	// none
 
-	// Set histogram binning
 
-	for(int i = 0; i < samples.size(); ++i){
-		for(int j = 0; j < selections.size(); ++j){
-			kH1DCache[i][j][0]  -> SetBins(10,   0.0, 400.0);
-			kH1DCache[i][j][1]  -> SetBins( 3,   0.0,   3.0);
-			kH1DCache[i][j][2]  -> SetBins( 5,   1.0,   6.0);
-			kH1DCache[i][j][3]  -> SetBins(40,   0.0,  40.0);
-			kH1DCache[i][j][4]  -> SetBins(20,   0.0,   0.2);
-			kH1DCache[i][j][5]  -> SetBins(12,   0.0,   2.4);
-			kH1DCache[i][j][6]  -> SetBins(20,   0.0,   1.0);
-			kH1DCache[i][j][7]  -> SetBins(20,  10.0,  70.0);
-			kH1DCache[i][j][8]  -> SetBins(20,   0.0,   0.2);
-			kH1DCache[i][j][9]  -> SetBins(12,   0.0,   2.4);
-			kH1DCache[i][j][10] -> SetBins(20,   0.0,   1.0);
-			kH1DCache[i][j][11] -> SetBins(20,  10.0,  70.0);
-		}
-	}
-			
+	// Defining all outputs
 
-	// Loop over samples
+	DefineOutputCache(42, samples, selections, h1ds, h2ds);
 
-	std::cout << "going to loop over samples" << std::endl;
-	LoopOverSamples(&AnalysisModules::Module12Kernel, samples, selections);
 
+	// Set histogram binning
 
-	// Write histograms and outputs to disk
+	for(int i = 0; i < samples.size(); ++i)
+		for(int j = 0; j < selections.size(); ++j)
+			for(int k = 0; k < h1ds.size(); ++k)
+				kH1DCache[i][j][k] -> SetBins(4, 0.0, 4.0);
 
-	WriteOutputCache(12, samples, selections);
-	
 
-	// Save fake ratio map in member variable
+	// Declare the loop over samples
 
+	AddModulePass(42, &AnalysisModules::Module42Kernel, &AnalysisModules::Module42Finish, samples, selections, selections);
 
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::Module12Kernel(float event_weight){
+void AnalysisModules::Module42Kernel(float event_weight){
 	/*
-  	kernel to module 12
-  	parameters: event_weight
-  	return: none
-  	*/
-	
-
-	// event variables
-
-	//kH1DCache[kSampleIterator][kSelectionIterator][0] -> Fill(kDefinedVariables["HT"][0]     , event_weight);
-	kH1DCache[kSampleIterator][kSelectionIterator][1] -> Fill(kNumberOfKinematicObjects["GJ"], event_weight);
-	kH1DCache[kSampleIterator][kSelectionIterator][2] -> Fill(kNumberOfKinematicObjects["BJ"], event_weight);
-	kH1DCache[kSampleIterator][kSelectionIterator][3] -> Fill((NVrtx>40)?40:NVrtx            , event_weight);
-
-
-	// variables of kinematic object "LM"
-
-	for(int i = 0; i < kNumberOfKinematicObjects["LM"]; ++i){
-		kH1DCache[kSampleIterator][kSelectionIterator][4] -> Fill(MuD0    -> at(kKinematicObjects["LM"][i]), event_weight);
-		kH1DCache[kSampleIterator][kSelectionIterator][5] -> Fill(MuEta   -> at(kKinematicObjects["LM"][i]), event_weight);
-		kH1DCache[kSampleIterator][kSelectionIterator][6] -> Fill(MuPFIso -> at(kKinematicObjects["LM"][i]), event_weight);
-		kH1DCache[kSampleIterator][kSelectionIterator][7] -> Fill(MuPt    -> at(kKinematicObjects["LM"][i]), event_weight);
-	}
-
-
-	// variables of kinematic object "TM"
-
-	for(int i = 0; i < kNumberOfKinematicObjects["TM"]; ++i){
-		kH1DCache[kSampleIterator][kSelectionIterator][8]  -> Fill(MuD0    -> at(kKinematicObjects["TM"][i]), event_weight);
-		kH1DCache[kSampleIterator][kSelectionIterator][9]  -> Fill(MuEta   -> at(kKinematicObjects["TM"][i]), event_weight);
-		kH1DCache[kSampleIterator][kSelectionIterator][10] -> Fill(MuPFIso -> at(kKinematicObjects["TM"][i]), event_weight);
-		kH1DCache[kSampleIterator][kSelectionIterator][11] -> Fill(MuPt    -> at(kKinematicObjects["TM"][i]), event_weight);
-	}
-
-
-	// variables of kinematic object "GJ"
-
-	//for(int i = 0; i < kNumberOfKinematicObjects["GJ"]; ++i){
-	//	kH1DCache[kSampleIterator][kSelectionIterator][8]  -> Fill(JetD0    -> at(kKinematicObjects["TM"][i]), event_weight);
-	//	kH1DCache[kSampleIterator][kSelectionIterator][9]  -> Fill(JetEta   -> at(kKinematicObjects["TM"][i]), event_weight);
-	//	kH1DCache[kSampleIterator][kSelectionIterator][10] -> Fill(JetPFIso -> at(kKinematicObjects["TM"][i]), event_weight);
-	//	kH1DCache[kSampleIterator][kSelectionIterator][11] -> Fill(JetPt    -> at(kKinematicObjects["TM"][i]), event_weight);
-	//}
-
-
+	kernel to module 42, the kernel of module 41 in the closure test mode; the
+	mode is set per call, such that both modules can share one loop
+	parameters: event_weight
+	return: none
+	*/
 
+	kClosureTest = true;
+	Module41Kernel(event_weight);
+	kClosureTest = false;
 
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::Module13Frame(){
+void AnalysisModules::Module42Finish(std::vector<Label> samples, std::vector<Label> selections){
+	/*
+	finishes module 42 once its loop is done, divides the prediction by the
+	observation and writes them
+	parameters: samples, selections
+	return: none
+	*/
 
-	std::vector<Label> samples;
-	std::vector<Label> h1d;
-	std::vector<Label> h2d;
 
-	samples.push_back("qcdmu20.");
+	// Divide the prediction by the observation, the ratios read from an
+	// earlier run are divided already
 
-	std::vector<Label> sample_names    = Tools::GetVectorFromMapKeys(Tools::GetSubSetOfMapByObjectNames(cSamples, samples));
-	std::vector<Label> selection_names;
+	for(int i = 0; i < samples.size(); ++i)
+		for(int j = 0; j < selections.size(); ++j)
+			if(!IsOutputRead(i, j)) kH1DCache[i][j][2] -> Divide(kH1DCache[i][j][1]);
 
-	LoopOverSamples(&AnalysisModules::Module13Kernel, sample_names, selection_names);
 
+	// Write histograms and outputs to disk
+
+	WriteOutputCache(42, samples, selections);
 
 }
 
 
 //____________________________________________________________________________
-void AnalysisModules::Module13Kernel(float event_weight){
-}
+void AnalysisModules::FillFakePrediction(int category, float factor){
+	/*
+	fills one category of the prediction with all event weights (variations
+	and bootstrap replicas included) scaled by a factor; in the closure test
+	the prediction is also filled into the histogram that becomes the ratio
+	parameters: category, factor
+	return: none
+	*/
 
+	if(factor == 0.) return;
 
+	kPredictionWeights.resize(kEventWeights.size());
+	for(int i = 0; i < kEventWeights.size(); ++i)
+		kPredictionWeights[i] = factor * kEventWeights[i];
 
+	kH1DCache[kSampleIterator][kSelectionIterator][0] -> Fill(category + 0.5, kPredictionWeights);
+	if(kClosureTest) kH1DCache[kSampleIterator][kSelectionIterator][2] -> Fill(category + 0.5, kPredictionWeights);
 
+}
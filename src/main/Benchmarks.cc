@@ -0,0 +1,210 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/head/Benchmarks.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CODE                                       **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+Benchmarks::Benchmarks(TString configuration_file){
+	/*
+	constructs the Benchmarks Class, which runs analysis modules and measures
+	the time spent in every phase of the event loop
+	parameters: configuration_file (path to configuration file)
+	return: none
+	*/
+
+	kVerbose -> Class("Benchmarks");
+	Initialize();
+	StartDileptons(configuration_file);
+
+}
+
+
+//____________________________________________________________________________
+Benchmarks::~Benchmarks(){
+	/*
+	destructs the Benchmarks Class
+	parameters: none
+	return: none
+	*/
+
+}
+
+
+//____________________________________________________________________________
+void Benchmarks::Initialize(){
+	/*
+	initializes the Benchmarks Class
+	parameters: none
+	return: none
+	*/
+
+	kNumberOfEvents = 0;
+	kModuleTime     = 0.;
+	kPhaseStart     = 0.;
+
+	for(int i = 0; i < 5; ++i)
+		kPhaseTimes[i] = 0.;
+
+}
+
+
+//____________________________________________________________________________
+void Benchmarks::RunBenchmark(int module_id){
+	/*
+	runs a module and measures its total time, the time of every phase and the
+	number of processed events
+	parameters: module_id
+	return: none
+	*/
+
+	Initialize();
+
+	double start = GetTime();
+	CallModuleByID(module_id);
+	kModuleTime = GetTime() - start;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR MEASURING                                              **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+long Benchmarks::GetPeakMemory(){
+	/*
+	returns the peak resident set size of the process
+	parameters: none
+	return: peak resident set size in kB
+	*/
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+
+	return usage.ru_maxrss;
+
+}
+
+
+//____________________________________________________________________________
+double Benchmarks::GetTime(){
+	/*
+	returns the time of a monotonic clock
+	parameters: none
+	return: time in seconds
+	*/
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + 1.e-9 * now.tv_nsec;
+
+}
+
+
+//____________________________________________________________________________
+void Benchmarks::EndLoopPhase(LoopPhase phase){
+	/*
+	adds the time since the end of the phase before to a phase of the event
+	loop of AnalysisModules, which marks the end of every phase; the first
+	mark of a loop only starts the clock, opening the next sample counts as
+	reading
+	parameters: phase
+	return: none
+	*/
+
+	double now = GetTime();
+
+	if(kPhaseStart > 0.) kPhaseTimes[phase] += now - kPhaseStart;
+	if(phase == reading) ++kNumberOfEvents;
+
+	kPhaseStart = now;
+
+}
+
+
+//____________________________________________________________________________
+void Benchmarks::WriteOutputCache(int module_id, std::vector<Label> sample_names, std::vector<Label> selection_names){
+	/*
+	writes the output cache and measures the time it takes
+	parameters: module_id, sample_names, selection_names
+	return: none
+	*/
+
+	double start = GetTime();
+	AnalysisModules::WriteOutputCache(module_id, sample_names, selection_names);
+	kPhaseTimes[writing] += GetTime() - start;
+
+	// the next loop starts its own clock
+	kPhaseStart = 0.;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR REPORTING                                              **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+TString Benchmarks::PrintReport(TString configuration_name, int module_id){
+	/*
+	prints the result of the last benchmark as one tab separated line; the time
+	not spent in any phase (setup, booking of histograms) is given as other
+	parameters: configuration_name, module_id
+	return: report line
+	*/
+
+	double other = kModuleTime;
+	for(int i = 0; i < 5; ++i)
+		other -= kPhaseTimes[i];
+
+	return Form("%s\t%d\t%lld\t%.1f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%ld\n",
+	            configuration_name.Data(), module_id, kNumberOfEvents,
+	            kModuleTime > 0. ? kNumberOfEvents / kModuleTime : 0., kModuleTime,
+	            kPhaseTimes[reading], kPhaseTimes[collecting], kPhaseTimes[selecting],
+	            kPhaseTimes[filling], kPhaseTimes[writing], other, GetPeakMemory());
+
+}
+
+
+//____________________________________________________________________________
+TString Benchmarks::PrintReportHeader(){
+	/*
+	prints the header of the benchmark report, times are given in seconds
+	parameters: none
+	return: header line
+	*/
+
+	return "#config\tmodule\tevents\tevents/s\ttotal\treading\tcollecting\tselecting\tfilling\twriting\tother\tpeakrss_kB\n";
+
+}
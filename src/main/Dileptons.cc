@@ -72,6 +72,36 @@ void Dileptons::Initialize(){
 	return: none
 	*/
 
+	cPlotFormats         = "png,pdf,root,C";
+	cRenderWorkers       = 4;
+	cSeparateOutputFiles = false;
+	cProfileAKROSD       = false;
+	cProgressInterval    = 60;
+	cFuseModules         = false;
+	cModuleWorkers       = 0;
+	cSkimSelections      = "";
+	cSkimBranches        = "*";
+	cSkimVariables       = "";
+	cSkimCompression     = 101;
+	cDerivedColumns      = 0;
+	cIncrementalRuns     = false;
+	cSelectionBitmaps    = false;
+	cCleaningObjects     = "";
+	cCleaningDeltaR      = 0.4;
+	cBootstrapReplicas   = 0;
+	cFakeRatioMap        = "";
+	cScanVariables       = "";
+	cScanSelections      = "";
+	cScanRegions         = "";
+	cServerSocket        = "";
+	cServerSamples       = "";
+	cServerMemory        = 2000;
+
+	kJetCleaningDone     = false;
+
+	kKinematicVariationIterator = 0;
+	kIsData                     = false;
+
 	kAFSFolder       = "/afs/cern.ch/user/c/";
 	kAFSFolder      += Tools::GetUserName();
 	kAFSFolder      += "/www/dileptons/";
@@ -104,7 +134,6 @@ void Dileptons::Initialize(){
 
 	kTemporaryFileConfiguration         = "0.cfg";
 	kTemporaryFileLog                   = "0.log";
-	kTemporaryFileTag                   = "tag.sh";
 
 
 	std::vector<std::vector<TString> > matrix = OtherInput::ReadMatrixFromListFile(Tools::ConvertTStringToStdString(kInfoFolder) + Tools::ConvertTStringToStdString(kInfoFileBasicKinematicObjects), "\t", 2);
@@ -120,14 +149,17 @@ void Dileptons::Initialize(){
 	kVerbose = new Verbose((DileptonsVerbose) 0, Tools::ConvertTStringToStdString(kInfoFolder) + Tools::ConvertTStringToStdString(kInfoFileErrorMessages), Tools::ConvertTStringToStdString(kInfoFolder) + Tools::ConvertTStringToStdString(kInfoFileSystemMessages));
 	kVerbose->Class("Dileptons");
 
-	kCanvas = new TCanvas("c", "C", 975, 600);
-	//	Style::SetCanvas(kCanvas, "c");
+	kProfiler    = new Profiler();
+	kRenderQueue = new RenderQueue(kVerbose, Tools::ExplodeTString(cPlotFormats, ","), cRenderWorkers);
+	kArena = new Arena();
+	kColumnStore = new ColumnStore();
+	kSelectionBitmap = new SelectionBitmap();
 
 }
 
 
 //____________________________________________________________________________
-bool Dileptons::CheckAKROSDStringForDefinedVariables(Label variable_name, AKROSD string, std::vector<Label> selected_objects, std::vector<Label> defined_variables){
+bool Dileptons::CheckAKROSDStringForDefinedVariables(Label variable_name, AKROSD string, const std::vector<Label> & selected_objects, const std::vector<Label> & defined_variables){
 	/*
 	checks the AKROSD string according to the rules of defined event variables
 	parameters: string (AKROSD string to be checked), object_selection_definitions
@@ -165,7 +197,7 @@ bool Dileptons::CheckAKROSDStringForDefinedVariables(Label variable_name, AKROSD
 
 
 //____________________________________________________________________________
-bool Dileptons::CheckAKROSDStringForEventSelection(AKROSD string, std::vector<Label> selected_objects, std::vector<Label> defined_variables){
+bool Dileptons::CheckAKROSDStringForEventSelection(AKROSD string, const std::vector<Label> & selected_objects, const std::vector<Label> & defined_variables){
 	/*
 	checks the AKROSD string according to the rules of event selection definitions
 	parameters: string (AKROSD string to be checked), object_selection_definitions
@@ -191,7 +223,7 @@ bool Dileptons::CheckAKROSDStringForEventSelection(AKROSD string, std::vector<La
 
 
 //____________________________________________________________________________
-bool Dileptons::CheckAKROSDStringForObjectSelection(Label object_name, AKROSD string, std::vector<Label> selected_objects, std::vector<Label> defined_variables){
+bool Dileptons::CheckAKROSDStringForObjectSelection(Label object_name, AKROSD string, const std::vector<Label> & selected_objects, const std::vector<Label> & defined_variables){
 	/*
 	checks the AKROSD string according to the rules of object selection definitions
 	parameters: string (AKROSD string to be checked)
@@ -305,8 +337,12 @@ void Dileptons::CheckConfiguration(){
 	// check user name
 	if(cUserName.Length() == 0) kVerbose->ErrorAndExit(3);
 
-	// check directories
-	if(cAFSPath.Length()    > 0 && (access(cAFSPath   , 0) != 0 || cAFSPath(cAFSPath.Length()-1,1)       != "/")) kVerbose->ErrorAndExit(4);
+	// check directories, the AFS webspace is only needed if the output is published
+	if(cMode != test) {
+		TString afs_folder = cAFSPath.Length() > 0 ? cAFSPath : kAFSFolder;
+		if(cAFSPath.Length() > 0 && (access(cAFSPath, 0) != 0 || cAFSPath(cAFSPath.Length()-1,1) != "/")) kVerbose->ErrorAndExit(4);
+		if(access(Tools::ConvertTStringToCString(afs_folder), 0) != 0 || !Tools::CheckDirectoryWritePermission(afs_folder)) kVerbose->ErrorAndExit(1);
+	}
 	if(cInputPath.Length()  > 0 && (access(cInputPath , 0) != 0 || cInputPath(cInputPath.Length()-1,1)   != "/")) kVerbose->ErrorAndExit(4);
 	if(cOutputPath.Length() > 0 && (access(cOutputPath, 0) != 0 || cOutputPath(cOutputPath.Length()-1,1) != "/")) kVerbose->ErrorAndExit(4);
 
@@ -323,18 +359,56 @@ void Dileptons::CheckConfiguration(){
 		if(module_ids[i] < 10 || (module_ids[i] <= 100 && module_ids[i] % 10 == 0) || (sketch_found && module_ids[i] < 100)) kVerbose->ErrorAndExit(6); 
 	}
 
+	// check module workers
+	if(cModuleWorkers < 0) kVerbose->ErrorAndExit(19);
+
+	// check the server, the samples it keeps in the memory must be given
+	if(cRunOn == server) {
+		if(cServerMemory < 0) kVerbose->ErrorAndExit(24);
+		std::vector<Label> server_samples = Tools::ExplodeTString(cServerSamples, ",");
+		for(int i = 0; i < server_samples.size() && cServerSamples.Length() > 0; ++i)
+			if(!Tools::FindElementInMapByKey(cSamples, server_samples[i])) kVerbose->ErrorAndExit(24);
+	}
+
+	// check skims, "all" copies the full samples
+	std::vector<Label> skim_selections;
+	std::vector<Label> skim_variables;
+	if(cSkimSelections.Length() > 0) skim_selections = Tools::ExplodeTString(cSkimSelections, ",");
+	if(cSkimVariables .Length() > 0) skim_variables  = Tools::ExplodeTString(cSkimVariables , ",");
+	for(int i = 0; i < skim_selections.size(); ++i)
+		if(skim_selections[i] != "all" && !Tools::FindElementInMapByKey(cEventSelectionDefinitions, skim_selections[i])) kVerbose->ErrorAndExit(20);
+	for(int i = 0; i < skim_variables.size(); ++i)
+		if(!Tools::FindElementInMapByKey(cDefinedVariableDefinitions, skim_variables[i])) kVerbose->ErrorAndExit(20);
+	if(cSkimCompression < 0 || cSkimCompression % 100 > 9) kVerbose->ErrorAndExit(20);
+
+	// check derived columns
+	if(cDerivedColumns < 0 || cDerivedColumns > 2) kVerbose->ErrorAndExit(21);
+
+	// check bootstrap replicas
+	if(cBootstrapReplicas < 0) kVerbose->ErrorAndExit(25);
+
+	// check plot rendering
+	if(cRenderWorkers < 0) kVerbose->ErrorAndExit(12);
+
+	std::vector<TString> plot_formats = Tools::ExplodeTString(cPlotFormats, ",");
+	for(int i = 0; i < plot_formats.size(); ++i)
+		if(!RenderQueue::IsFormat(plot_formats[i])) kVerbose->ErrorAndExit(12);
+
 	// check AKROSD strings
 
+	std::vector<Label> selected_objects  = Tools::GetVectorFromMapKeys(cObjectSelectionDefinitions);
+	std::vector<Label> defined_variables = Tools::GetVectorFromMapKeys(cDefinedVariableDefinitions);
+
 	for(std::map<Label, AKROSD>::iterator iterator = cObjectSelectionDefinitions.begin(); iterator != cObjectSelectionDefinitions.end(); ++iterator)
-		if(!CheckAKROSDStringForObjectSelection(iterator->first, iterator->second, Tools::GetVectorFromMapKeys(cObjectSelectionDefinitions), Tools::GetVectorFromMapKeys(cDefinedVariableDefinitions))) 
+		if(!CheckAKROSDStringForObjectSelection(iterator->first, iterator->second, selected_objects, defined_variables)) 
 			kVerbose->ErrorAndExit(7);
 
 	for(std::map<Label, AKROSD>::iterator iterator = cDefinedVariableDefinitions.begin(); iterator != cDefinedVariableDefinitions.end(); ++iterator)
-		if(!CheckAKROSDStringForDefinedVariables(iterator->first, iterator->second, Tools::GetVectorFromMapKeys(cObjectSelectionDefinitions), Tools::GetVectorFromMapKeys(cDefinedVariableDefinitions))) 
+		if(!CheckAKROSDStringForDefinedVariables(iterator->first, iterator->second, selected_objects, defined_variables)) 
 			kVerbose->ErrorAndExit(8);
 	
 	for(std::map<Label, AKROSD>::iterator iterator = cEventSelectionDefinitions.begin(); iterator != cEventSelectionDefinitions.end(); ++iterator)
-		if(!CheckAKROSDStringForEventSelection(iterator->second, Tools::GetVectorFromMapKeys(cObjectSelectionDefinitions), Tools::GetVectorFromMapKeys(cDefinedVariableDefinitions))) 
+		if(!CheckAKROSDStringForEventSelection(iterator->second, selected_objects, defined_variables)) 
 			kVerbose->ErrorAndExit(9);
 
 
@@ -356,7 +430,6 @@ void Dileptons::CheckResources(){
 	*/
 
 	// check existence of directories
-	if(access(Tools::ConvertTStringToCString(kAFSFolder)      , 0) != 0) kVerbose->ErrorAndExit(1);
 	if(access(Tools::ConvertTStringToCString(kInfoFolder)     , 0) != 0) kVerbose->ErrorAndExit(1);
 	if(access(Tools::ConvertTStringToCString(kInputFolder)    , 0) != 0) kVerbose->ErrorAndExit(1);
 	if(access(Tools::ConvertTStringToCString(kOutputFolder)   , 0) != 0) kVerbose->ErrorAndExit(1);
@@ -385,7 +458,6 @@ void Dileptons::CheckResources(){
 
 	if(!Tools::CheckDirectoryWritePermission(kOutputFolder   )) kVerbose->ErrorAndExit(1);
 	if(!Tools::CheckDirectoryWritePermission(kTemporaryFolder)) kVerbose->ErrorAndExit(1);
-	if(!Tools::CheckDirectoryWritePermission(kAFSFolder      )) kVerbose->ErrorAndExit(1);
 
 }
 
@@ -467,21 +539,31 @@ void Dileptons::CreateOutputStructure(){
 	return: none
 	*/
 
+	std::string configplot_folder = Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/";
+	std::string template_folder   = Tools::ConvertTStringToStdString(kTemplateFolder);
+	bool success = true;
 
 	if(kConfigplot == "0-0")
-		Tools::ExecuteBashCommand("rm -r " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot));
+		success = success && FileOperations::RemoveDirectory(configplot_folder);
+
+	success = success && FileOperations::CreateDirectory(configplot_folder + "0");
+	success = success && FileOperations::MoveFile(Tools::ConvertTStringToStdString(kTemporaryFolder) + Tools::ConvertTStringToStdString(kTemporaryFileConfiguration), configplot_folder + "0/" + Tools::ConvertTStringToStdString(kTemporaryFileConfiguration));
+	success = success && FileOperations::CopyFile(template_folder + Tools::ConvertTStringToStdString(kTemplateFileIndexModules), configplot_folder + "index.php", false);
+
+	if(cSkimSelections.Length() > 0)
+		success = success && FileOperations::CreateDirectory(configplot_folder + "skims");
 
-	Tools::ExecuteBashCommand("mkdir " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot));
-	Tools::ExecuteBashCommand("mkdir " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/0");
-	Tools::ExecuteBashCommand("mv " + Tools::ConvertTStringToStdString(kTemporaryFolder) + Tools::ConvertTStringToStdString(kTemporaryFileConfiguration) + " " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/0/" + Tools::ConvertTStringToStdString(kTemporaryFileConfiguration));
-	Tools::ExecuteBashCommand("cp " + Tools::ConvertTStringToStdString(kTemplateFolder) + Tools::ConvertTStringToStdString(kTemplateFileIndexModules) + " " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/index.php");
+	if(cSelectionBitmaps)
+		success = success && FileOperations::CreateDirectory(configplot_folder + "bitmaps");
 
 	for(int i = 0; i < kModules.size(); ++i){
-		Tools::ExecuteBashCommand("mkdir " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/" + Tools::ConvertIntToStdString(kModules[i]));
-		Tools::ExecuteBashCommand("cp " + Tools::ConvertTStringToStdString(kTemplateFolder) + Tools::ConvertTStringToStdString(kTemplateFileIndexPlots) + " " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/" + Tools::ConvertTStringToStdString(kModules[i]) + "/index.php");
+		success = success && FileOperations::CreateDirectory(configplot_folder + Tools::ConvertIntToStdString(kModules[i]));
+		success = success && FileOperations::CopyFile(template_folder + Tools::ConvertTStringToStdString(kTemplateFileIndexPlots), configplot_folder + Tools::ConvertIntToStdString(kModules[i]) + "/index.php", false);
 	}
 
-	kVerbose -> SetLogFilePath(Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/0/" + Tools::ConvertTStringToStdString(kTemporaryFileLog));
+	if(!success) kVerbose -> Error(11);
+
+	kVerbose -> SetLogFilePath(configplot_folder + "0/" + Tools::ConvertTStringToStdString(kTemporaryFileLog));
 
 }
 
@@ -501,6 +583,312 @@ void Dileptons::FillEventList(){
 }
 
 
+//____________________________________________________________________________
+void Dileptons::FillEventTree(){
+	/*
+	copies the current event into the skim of the sample and selection, if
+	there is one, together with the values of the defined variables given in
+	SkimVariables
+	parameters: none
+	return: none
+	*/
+
+	if(kEventTreeCache.size() <= kSampleIterator || kEventTreeCache[kSampleIterator].size() <= kSelectionIterator) return;
+
+	TTree * tree = kEventTreeCache[kSampleIterator][kSelectionIterator];
+	if(tree == 0) return;
+
+	for(int i = 0; i < kSkimVariables.size(); ++i){
+		if(RecreateDefinedVariable(kSkimVariables[i])) ParseDefinedVariable(kSkimVariables[i]);
+		kSkimVariableValues[i] -> assign(kDefinedVariables[kSkimVariables[i]].begin(), kDefinedVariables[kSkimVariables[i]].end());
+	}
+
+	tree -> Fill();
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::FillSelectionBitmap(){
+	/*
+	sets the bits of the current entry in the selection bitmap, i.e. takes the
+	results of the event selections that the loop has evaluated on the nominal
+	event, evaluates the other event selections, counts every object on it, and
+	appends them
+	parameters: none
+	return: none
+	*/
+
+	if(!kSelectionBitmap -> IsOpen()) return;
+
+	int bit = 0;
+
+	for(std::map<Label, AKROSD>::iterator i = cEventSelectionDefinitions.begin(); i != cEventSelectionDefinitions.end(); ++i){
+		std::map<Label, bool>::iterator result = kSelectionResults.find(i -> first);
+		kSelectionBitmap -> SetBit(bit++, (result != kSelectionResults.end()) ? result -> second : ParseEventSelection(i -> second));
+	}
+
+	// the objects are counted when they are collected, only objects that have
+	// not been collected on this event yet are collected here
+	for(std::map<Label, AKROSD>::iterator i = cObjectSelectionDefinitions.begin(); i != cObjectSelectionDefinitions.end(); ++i){
+		int count = FindKinematicObjects(i -> first);
+		if(count == -1) {
+			CollectKinematicObjects(i -> first, i -> second);
+			CountKinematicObjects(i -> first);
+			count = kNumberOfKinematicObjects[i -> first];
+		}
+		kSelectionBitmap -> SetBit(bit + std::min(count, 3), true);
+		bit += 4;
+	}
+
+	kSelectionBitmap -> Fill();
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::OpenEventTrees(Label sample_key, std::vector<Label> selection_keys){
+	/*
+	opens the skims of the current sample, one tree in its own file for every
+	selection in SkimSelections that has not been skimmed by a module before;
+	the trees keep the branches in SkimBranches and the name of the input tree,
+	such that a skim can be used as a sample again; the skim "all" is written
+	right away by copying the baskets of the full sample
+	parameters: sample_key, selection_keys (selections of the loop)
+	return: none
+	*/
+
+	kEventTreeCache[kSampleIterator].assign(selection_keys.size(), (TTree*) 0);
+
+	if(cSkimSelections.Length() == 0) return;
+
+	std::vector<Label> skims     = Tools::ExplodeTString(cSkimSelections, ",");
+	std::vector<TString> branches  = Tools::ExplodeTString(cSkimBranches  , ",");
+
+	// the defined variables are split once here and reused for every event
+	kSkimVariables.clear();
+	if(cSkimVariables.Length() > 0) kSkimVariables = Tools::ExplodeTString(cSkimVariables, ",");
+
+	TString output_folder = kOutputFolder + kConfigplot + "/skims/";
+
+
+	// the buffers of the defined variables are shared by all skims
+
+	while(kSkimVariableValues.size() < kSkimVariables.size())
+		kSkimVariableValues.push_back(new std::vector<float>());
+
+
+	// full copy of the sample
+
+	if(Tools::FindElementInVector(skims, (Label) "all") && !Tools::FindElementInVector(kSkims, sample_key + "/all")){
+		if(!OtherOutput::WriteTreeCopy(output_folder, sample_key + "_all", kRootTree, cSamples[sample_key] -> GetMaxEntries(), branches, cSkimCompression)) kVerbose -> Error(11);
+		kSkims.push_back(sample_key + "/all");
+	}
+
+
+	// one tree per selection, the blocks of the kinematic variations are not skimmed
+
+	for(int j = 0; j < selection_keys.size(); ++j){
+		if(!Tools::FindElementInVector(skims, selection_keys[j]) || Tools::FindElementInVector(kSkims, sample_key + "/" + selection_keys[j])) continue;
+
+		TTree * tree = OtherOutput::OpenTreeToWrite(output_folder, sample_key + "_" + selection_keys[j], kRootTree, branches, cSkimCompression);
+		if(tree == 0) {
+			kVerbose -> Error(11);
+			continue;
+		}
+
+		for(int k = 0; k < kSkimVariables.size(); ++k)
+			tree -> Branch(kSkimVariables[k], &kSkimVariableValues[k]);
+
+		kEventTreeCache[kSampleIterator][j] = tree;
+		kSkims.push_back(sample_key + "/" + selection_keys[j]);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::CloseEventTrees(){
+	/*
+	writes and closes the skims of the current sample
+	parameters: none
+	return: none
+	*/
+
+	for(int j = 0; j < kEventTreeCache[kSampleIterator].size(); ++j){
+		if(kEventTreeCache[kSampleIterator][j] == 0) continue;
+		if(!OtherOutput::CloseTreeAndWrite(kEventTreeCache[kSampleIterator][j])) kVerbose -> Error(11);
+		kEventTreeCache[kSampleIterator][j] = 0;
+	}
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::OpenDerivedColumns(Label sample_key){
+	/*
+	opens the derived columns of a sample, i.e. the values of the defined
+	variables (DerivedColumns 1) and also the indices of the selected objects
+	(DerivedColumns 2) of every entry; they are kept in output/columns/<sample>
+	in one file per definition and hash, such that a column is only computed
+	anew if its definition or one it uses has changed
+	parameters: sample_key
+	return: none
+	*/
+
+	if(cDerivedColumns == 0) return;
+
+	kColumnStore -> Open(kOutputFolder + "columns/" + sample_key + "/", cSamples[sample_key] -> GetMaxEntries());
+	if(!kColumnStore -> IsOpen()) {
+		kVerbose -> Error(11);
+		return;
+	}
+
+	for(std::map<Label, AKROSD>::iterator i = cDefinedVariableDefinitions.begin(); i != cDefinedVariableDefinitions.end(); ++i){
+		TString hash = GetDefinitionHash(i -> first, sample_key);
+		if(hash.Length() > 0) kColumnStore -> AddColumn(i -> first, hash, false);
+	}
+
+	if(cDerivedColumns < 2) return;
+
+	for(std::map<Label, AKROSD>::iterator i = cObjectSelectionDefinitions.begin(); i != cObjectSelectionDefinitions.end(); ++i){
+		TString hash = GetDefinitionHash(i -> first, sample_key);
+		if(hash.Length() > 0) kColumnStore -> AddColumn(i -> first, hash, true);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::CloseDerivedColumns(){
+	/*
+	closes the derived columns of the current sample, the ones computed in this
+	run are kept if they are complete
+	parameters: none
+	return: none
+	*/
+
+	if(kColumnStore -> IsOpen()) kColumnStore -> Close();
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::OpenSelectionBitmap(Label sample_key, std::vector<Label> selection_keys){
+	/*
+	opens the selection bitmap of a sample, with one bit per event selection and
+	four per object (0, 1, 2 and at least 3 objects) for every entry; it is
+	written to bitmaps/<sample>.root once per sample, by the first loop over
+	the sample that evaluates event selections
+	parameters: sample_key, selection_keys (selections of the loop)
+	return: none
+	*/
+
+	kSelectionResults.clear();
+
+	if(!cSelectionBitmaps || selection_keys.size() == 0) return;
+	if(Tools::FindElementInVector(kSelectionBitmapSamples, sample_key)) return;
+
+	std::vector<Label> labels;
+
+	for(std::map<Label, AKROSD>::iterator i = cEventSelectionDefinitions.begin(); i != cEventSelectionDefinitions.end(); ++i)
+		labels.push_back(i -> first);
+
+	for(std::map<Label, AKROSD>::iterator i = cObjectSelectionDefinitions.begin(); i != cObjectSelectionDefinitions.end(); ++i){
+		labels.push_back("#" + i -> first + "=0");
+		labels.push_back("#" + i -> first + "=1");
+		labels.push_back("#" + i -> first + "=2");
+		labels.push_back("#" + i -> first + ">3");
+	}
+
+	if(!kSelectionBitmap -> Open(kOutputFolder + kConfigplot + "/bitmaps/" + sample_key + ".root", labels, cSamples[sample_key] -> GetMaxEntries())) {
+		kVerbose -> Error(11);
+		return;
+	}
+
+	kSelectionBitmapSamples.push_back(sample_key);
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::CloseSelectionBitmap(){
+	/*
+	writes and closes the selection bitmap of the current sample
+	parameters: none
+	return: none
+	*/
+
+	if(kSelectionBitmap -> IsOpen() && !kSelectionBitmap -> Close()) kVerbose -> Error(11);
+
+}
+
+
+//____________________________________________________________________________
+TString Dileptons::GetDefinitionHash(Label label, Label sample_key){
+	/*
+	returns the hash of the definition of an object or defined variable, taken
+	together with all definitions it uses, the settings that change the objects,
+	the code version and the sample file (path, size, modification time and
+	entries); the labels used are found by their names in the AKROSD strings,
+	so a definition may depend on more labels than it needs but never on less
+	parameters: label, sample_key
+	return: hash (8 hex digits), "" (if the definition uses a fixed object * or
+	        the sample file cannot be found)
+	*/
+
+	std::map<Label, AKROSD> definitions = cObjectSelectionDefinitions;
+	definitions.insert(cDefinedVariableDefinitions.begin(), cDefinedVariableDefinitions.end());
+
+
+	// collect the definition and all definitions it uses
+
+	std::vector<Label> used(1, label);
+
+	for(int i = 0; i < used.size(); ++i){
+		if(definitions[used[i]].Index("*") > -1) return "";
+		for(std::map<Label, AKROSD>::iterator j = definitions.begin(); j != definitions.end(); ++j)
+			if(definitions[used[i]].Index(j -> first) > -1 && !Tools::FindElementInVector(used, j -> first))
+				used.push_back(j -> first);
+	}
+
+	std::sort(used.begin(), used.end());
+
+
+	// hash all of it
+
+	TString key = GetSampleIdentity(sample_key);
+	if(key.Length() == 0) return "";
+
+	key += "|" + kVersion;
+	key += Form("|%d|%s|%f", cJetEnergyCorrection, cCleaningObjects.Data(), cCleaningDeltaR);
+	for(int i = 0; i < used.size(); ++i)
+		key += "|" + used[i] + "=" + definitions[used[i]];
+
+	return Form("%08x", key.Hash());
+
+}
+
+
+//____________________________________________________________________________
+TString Dileptons::GetSampleIdentity(Label sample_key){
+	/*
+	returns what identifies the input of a sample, i.e. the path, size and
+	modification time of its file and the number of entries looped over
+	parameters: sample_key
+	return: identity, "" (if the file cannot be found)
+	*/
+
+	struct stat status;
+	TString path = cSamples[sample_key] -> GetPath();
+
+	if(stat(Tools::ConvertTStringToCString(path), &status) != 0) return "";
+
+	return Form("%s:%lld:%lld:%lld", path.Data(), (long long) status.st_size, (long long) status.st_mtime, (long long) cSamples[sample_key] -> GetMaxEntries());
+
+}
+
+
 //____________________________________________________________________________
 void Dileptons::EndDileptons(){
 	/*
@@ -509,6 +897,8 @@ void Dileptons::EndDileptons(){
 	return: none
 	*/
 
+	if(!kRenderQueue -> Wait()) kVerbose -> Error(13);
+
 	kVerbose -> ExecutionTime();
 	kVerbose -> WriteLogFile();
 	FinalizeOutput();
@@ -520,22 +910,29 @@ void Dileptons::EndDileptons(){
 //____________________________________________________________________________
 void Dileptons::FinalizeOutput(){
 	/*
-	copies log file to configplot folder and the entire configplot folder onto AFS webspace
+	copies log file to configplot folder and the entire configplot folder onto AFS webspace;
+	the module folders have been published already after every module, so we only copy
+	what is left and wait for the last publishing to finish
 	parameters: none
 	return: none
 	*/
 	
 	if(cMode == test) return;
 
-	//Tools::ExecuteBashCommand("mv " + Tools::ConvertTStringToStdString(kTemplateFolder) + Tools::ConvertTStringToStdString(kTemporaryFileLog) + " " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/0/" + Tools::ConvertTStringToStdString(kTemporaryFileLog));
-
 	TString cp_folder = Tools::ConvertStdStringToTString(Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/0/");
 	OtherOutput::WriteToTextFile(cp_folder, "username.txt", cUserName);	
 
-	if(access(Tools::ConvertStdStringToCString(Tools::ConvertTStringToStdString(kAFSFolder) + "index.php"), 0) != 0) 
-		Tools::ExecuteBashCommand("cp " + Tools::ConvertTStringToStdString(kTemplateFolder) + Tools::ConvertTStringToStdString(kTemplateFileIndexConfigplots) + " " + Tools::ConvertTStringToStdString(kAFSFolder) + "index.php");
+	std::string afs_folder        = Tools::ConvertTStringToStdString(kAFSFolder);
+	std::string configplot_folder = Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + "/";
+	bool success = FileOperations::WaitForPublishing();
+
+	if(!FileOperations::ExistsFile(afs_folder + "index.php")) 
+		success = success && FileOperations::CopyFile(Tools::ConvertTStringToStdString(kTemplateFolder) + Tools::ConvertTStringToStdString(kTemplateFileIndexConfigplots), afs_folder + "index.php");
 
-	Tools::ExecuteBashCommand("cp -r " + Tools::ConvertTStringToStdString(kOutputFolder) + Tools::ConvertTStringToStdString(kConfigplot) + " " + Tools::ConvertTStringToStdString(kAFSFolder) + Tools::ConvertTStringToStdString(kConfigplot));
+	success = success && FileOperations::CopyDirectory(configplot_folder + "0", afs_folder + Tools::ConvertTStringToStdString(kConfigplot) + "/0");
+	success = success && FileOperations::CopyFile(configplot_folder + "index.php", afs_folder + Tools::ConvertTStringToStdString(kConfigplot) + "/index.php");
+
+	if(!success) kVerbose -> Error(11);
 
 }
 
@@ -653,6 +1050,25 @@ TString Dileptons::GetOutputName(int module_id, OutputType output_type, TString
 }
 
 
+//____________________________________________________________________________
+void Dileptons::PublishModuleOutput(int module_id){
+	/*
+	starts copying the output folder of a module onto the AFS webspace in the
+	background, such that the copying overlaps with processing the next module
+	parameters: module_id
+	return: none
+	*/
+
+	if(cMode == test) return;
+
+	std::string module_folder = Tools::ConvertTStringToStdString(kConfigplot) + "/" + Tools::ConvertIntToStdString(module_id);
+
+	if(!FileOperations::PublishDirectory(Tools::ConvertTStringToStdString(kOutputFolder) + module_folder, Tools::ConvertTStringToStdString(kAFSFolder) + module_folder))
+		kVerbose -> Error(11);
+
+}
+
+
 //____________________________________________________________________________
 void Dileptons::LoadConfigurationFile(TString configuration_file){
 	/*
@@ -690,17 +1106,43 @@ void Dileptons::LoadConfigurationFile(TString configuration_file){
 			else if (type == "TString" && name == "RunOn"     ) cRunOn      = Tools::ConvertTStringToDileptonsRunOn(value);
 			else if (type == "TString" && name == "Modules"   ) cModules    = value;
 			else if (type == "int"     && name == "ModuleList") cModuleList = value.Atoi();
+			else if (type == "TString" && name == "PlotFormats"  ) cPlotFormats   = value;
+			else if (type == "int"     && name == "RenderWorkers") cRenderWorkers = value.Atoi();
+			else if (type == "bool"    && name == "SeparateOutputFiles") cSeparateOutputFiles = (bool) value.Atoi();
+			else if (type == "bool"    && name == "ProfileAKROSD"      ) cProfileAKROSD       = (bool) value.Atoi();
+			else if (type == "int"     && name == "ProgressInterval"   ) cProgressInterval    = value.Atoi();
+			else if (type == "bool"    && name == "FuseModules"        ) cFuseModules         = (bool) value.Atoi();
+			else if (type == "int"     && name == "ModuleWorkers"      ) cModuleWorkers       = value.Atoi();
+			else if (type == "TString" && name == "SkimSelections"     ) cSkimSelections      = value;
+			else if (type == "TString" && name == "SkimBranches"       ) cSkimBranches        = value;
+			else if (type == "TString" && name == "SkimVariables"      ) cSkimVariables       = value;
+			else if (type == "int"     && name == "SkimCompression"    ) cSkimCompression     = value.Atoi();
+			else if (type == "int"     && name == "DerivedColumns"     ) cDerivedColumns      = value.Atoi();
+			else if (type == "bool"    && name == "IncrementalRuns"    ) cIncrementalRuns     = (bool) value.Atoi();
+			else if (type == "bool"    && name == "SelectionBitmaps"   ) cSelectionBitmaps    = (bool) value.Atoi();
+			else if (type == "TString" && name == "ServerSocket"       ) cServerSocket        = value;
+			else if (type == "TString" && name == "ServerSamples"      ) cServerSamples       = value;
+			else if (type == "int"     && name == "ServerMemory"       ) cServerMemory        = value.Atoi();
 		}
 
 		if(symbol == "v"){
 			if      (type == "int"     && name == "JetEnergyCorrection") cJetEnergyCorrection = value.Atoi();
 			else if (type == "float"   && name == "Luminosity"         ) cLuminosity          = value.Atof();
 			else if (type == "bool"    && name == "PileUpReweighting"  ) cPileUpReweighting   = (bool) value.Atoi();
+			else if (type == "TString" && name == "CleaningObjects"    ) cCleaningObjects     = value;
+			else if (type == "float"   && name == "CleaningDeltaR"     ) cCleaningDeltaR      = value.Atof();
+			else if (type == "int"     && name == "BootstrapReplicas"  ) cBootstrapReplicas   = value.Atoi();
+			else if (type == "TString" && name == "FakeRatioMap"       ) cFakeRatioMap        = value;
+			else if (type == "TString" && name == "ScanVariables"      ) cScanVariables       = value;
+			else if (type == "TString" && name == "ScanSelections"     ) cScanSelections      = value;
+			else if (type == "TString" && name == "ScanRegions"        ) cScanRegions         = value;
 		}
 
 		if(symbol == "o" && type == "AKROSD"  && name != "") cObjectSelectionDefinitions[name] = value.ReplaceAll("\t", "");
 		if(symbol == "d" && type == "AKROSD"  && name != "") cDefinedVariableDefinitions[name] = value.ReplaceAll("\t", "");
 		if(symbol == "e" && type == "AKROSD"  && name != "") cEventSelectionDefinitions[name]  = value.ReplaceAll("\t", "");
+		if(symbol == "w" && type == "TString" && name != "") cWeightDefinitions[name]          = value.ReplaceAll("\t", "");
+		if(symbol == "k" && type == "TString" && name != "") cKinematicVariationDefinitions[name] = value.ReplaceAll("\t", "");
 
 
 		if(symbol == "n" && type == "int"     && name == "Verbose") {
@@ -858,6 +1300,7 @@ void Dileptons::SetVersion(){
 	*/
 
 	kVersion = Tools::ExecuteShellScript(kTemplateFolder + kTemplateFileVersion);
+	kVersion = kVersion.Strip(TString::kTrailing, '\n');
 
 }
 
@@ -902,7 +1345,8 @@ void Dileptons::StartDileptons(TString configuration_file){
 //_____________________________________________________________________________________
 void Dileptons::TagCode(){
 	/*
-	uses a template to create a lightweight tag automatically after running	the code
+	uses a template to create a lightweight tag automatically after running	the code;
+	the filled template is piped into the shell directly, there is no temporary script
 	paramters: none
 	return: none
 	*/
@@ -916,22 +1360,14 @@ void Dileptons::TagCode(){
 	
 	if(template_file.is_open())
 		while(getline(template_file, line))
-			template_text += line;
+			template_text += line + "\n";
 		
 	template_file.close();
 		
 	Tools::ReplaceAll(template_text, "__VERSION__", Tools::ConvertTStringToStdString(kVersion));
 	Tools::ReplaceAll(template_text, "__CONFIGPLOT__", Tools::ConvertTStringToStdString(kConfigplot));
 	
-	ofstream execute_file;
-	execute_file.open(Tools::ConvertStdStringToCString(Tools::ConvertTStringToStdString(kTemporaryFolder) + Tools::ConvertTStringToStdString(kTemporaryFileTag)));
-	execute_file << template_text;
-	execute_file.close();
-
-	Tools::ExecuteBashCommand("chmod 0755 " + Tools::ConvertTStringToStdString(kTemporaryFolder) + Tools::ConvertTStringToStdString(kTemporaryFileTag));
-	Tools::ExecuteShellScript(Tools::ConvertTStringToStdString(kTemporaryFolder) + Tools::ConvertTStringToStdString(kTemporaryFileTag));
-	Tools::ExecuteBashCommand("rm " + Tools::ConvertTStringToStdString(kTemporaryFolder) + Tools::ConvertTStringToStdString(kTemporaryFileTag));
-	
+	Tools::ExecuteShellScriptText(Tools::ConvertStdStringToTString(template_text));
 	
 }
 
@@ -955,6 +1391,23 @@ void Dileptons::UseConfigurationVariables(){
 	else                     kModules = Tools::ConvertTStringVectorToIntVector(Tools::ExplodeTString(cModules,","));
 
 	kVerbose -> SetNumberOfModules(kModules.size());
+	kVerbose -> SetProgressInterval(cProgressInterval);
+
+	kProfiler -> SetActive(cProfileAKROSD);
+	kProfiler -> AddDefinitions("o", cObjectSelectionDefinitions);
+	kProfiler -> AddDefinitions("d", cDefinedVariableDefinitions);
+	kProfiler -> AddDefinitions("e", cEventSelectionDefinitions);
+
+	// without separate output files only the png plots of the web index are rendered
+	std::vector<TString> plot_formats = Tools::ExplodeTString(cPlotFormats, ",");
+	if(!cSeparateOutputFiles) plot_formats = std::vector<TString>(1, "png");
+	kRenderQueue -> SetFormats(plot_formats);
+	kRenderQueue -> SetNumberOfWorkers(cRenderWorkers);
+
+	kCleaningObjects = Tools::ExplodeTString(cCleaningObjects, ",");
+
+	SetWeightVariations();
+	SetKinematicVariations();
 
 }
 
@@ -1020,7 +1473,7 @@ std::vector<Label> Dileptons::GetAKROSDLabelsInIfThElStatement(AKROSD statement)
 
 
 //____________________________________________________________________________
-std::vector<AKROSD> Dileptons::GetAKROSDStatements(AKROSD string, AKROSD first_delimiter, AKROSD second_delimiter){
+ArenaTStringVector Dileptons::GetAKROSDStatements(AKROSD string, AKROSD first_delimiter, AKROSD second_delimiter){
 	/*
 	collects all regular and irregular statements in an AKROSD string, i.e. 
 	splits up the string by AND (,) and OR (|) and strips off the brackets
@@ -1028,11 +1481,14 @@ std::vector<AKROSD> Dileptons::GetAKROSDStatements(AKROSD string, AKROSD first_d
 	return: std::vector of statements
 	*/
 
-	std::vector<AKROSD> result;
+	ArenaTStringVector result(kArena);
+	ArenaTStringVector first(kArena);
+	ArenaTStringVector second(kArena);
 
-	std::vector<AKROSD> first = Tools::ExplodeTString(string, first_delimiter);
+	Tools::ExplodeTString(string, first_delimiter, first);
 	for(int i = 0; i < first.size(); ++i){
-		std::vector<AKROSD> second = Tools::ExplodeTString(first[i], second_delimiter);
+		second.clear();
+		Tools::ExplodeTString(first[i], second_delimiter, second);
 		for(int j = 0; j < second.size(); ++j) 
 			result.push_back(second[j].ReplaceAll("(", "").ReplaceAll(")", ""));
 	}
@@ -1043,7 +1499,7 @@ std::vector<AKROSD> Dileptons::GetAKROSDStatements(AKROSD string, AKROSD first_d
 
 
 //____________________________________________________________________________
-std::vector<float> Dileptons::GetAnalysisToolsArgumentList(Label statement){
+ArenaFloatVector Dileptons::GetAnalysisToolsArgumentList(Label statement){
 	/*
 	collects the values we get by evaluating the statement; this can be either
 	a list of all object variables (e.g. LM.PT can have 3 values one for each
@@ -1052,7 +1508,7 @@ std::vector<float> Dileptons::GetAnalysisToolsArgumentList(Label statement){
 	return: vector of values
 	*/
 
-	std::vector<float> results;
+	ArenaFloatVector results(kArena);
 
 
 	// statement is an object variable
@@ -1073,7 +1529,7 @@ std::vector<float> Dileptons::GetAnalysisToolsArgumentList(Label statement){
 	else if(Tools::FindElementInMapByKey(cDefinedVariableDefinitions, statement)){
 		if(RecreateDefinedVariable(statement)){
 			//std::cout << "parsing at point (2) " << statement << std::endl;
-			kDefinedVariables[statement] = ParseVariableDefinition(cDefinedVariableDefinitions[statement]);
+			ParseDefinedVariable(statement);
 		}
 
 		results = kDefinedVariables[statement];
@@ -1086,7 +1542,7 @@ std::vector<float> Dileptons::GetAnalysisToolsArgumentList(Label statement){
 
 
 //____________________________________________________________________________
-std::vector<float> Dileptons::GetVectorOfParseResults(AKROSD operation, std::vector<AKROSD> arguments, int object_index){
+ArenaFloatVector Dileptons::GetVectorOfParseResults(AKROSD operation, const ArenaTStringVector & arguments, int object_index){
 	/*
   	takes an operation and a list of arguments and returns the vector of float
   	which contains the results for the operation executed for every combination
@@ -1105,13 +1561,16 @@ std::vector<float> Dileptons::GetVectorOfParseResults(AKROSD operation, std::vec
 
 
 	int number_of_combinations = 1;
-	std::vector<float> results;
-	std::vector<AKROSD> objects;
-	std::vector<int> argument_correspondences;
-	std::vector<int> object_iterators;
-	std::vector<int> iterators_to_use;
+	ArenaFloatVector results(kArena);
+	ArenaTStringVector objects(kArena);
+	ArenaIntVector argument_correspondences(kArena);
+	ArenaIntVector object_iterators(kArena);
+	ArenaIntVector iterators_to_use(kArena);
 	AKROSD object_to_fix;
 	int iterator_to_fix;
+	AKROSD all_argument = arguments.size() > 0 ? arguments[0] : "";
+
+	all_argument.ReplaceAll("-all", "");
 
 	//std::cout << "getting vector of parse results for " << operation << std::endl;
 
@@ -1159,7 +1618,7 @@ std::vector<float> Dileptons::GetVectorOfParseResults(AKROSD operation, std::vec
 	for(int i = 0; i < arguments.size(); ++i){
 		if(Tools::FindElementInMapByKey(cDefinedVariableDefinitions, arguments[i]) && RecreateDefinedVariable(arguments[i])){
 			//std::cout << "parsing at point (3) " << arguments[i] << std::endl;
-			kDefinedVariables[arguments[i]] = ParseVariableDefinition(cDefinedVariableDefinitions[arguments[i]]);
+			ParseDefinedVariable(arguments[i]);
 		}
 	}
 
@@ -1208,7 +1667,7 @@ std::vector<float> Dileptons::GetVectorOfParseResults(AKROSD operation, std::vec
 			results.push_back(ParseAKROSDVariable(arguments[0], iterators_to_use[argument_correspondences[0]]) - ParseAKROSDVariable(arguments[1], iterators_to_use[argument_correspondences[1]]));
 		
 		else if(operation == "Absolute")
-			results.push_back(AnalysisTools::Absolute(GetAnalysisToolsArgumentList(arguments[0].ReplaceAll("-all", ""))[0]));
+			results.push_back(AnalysisTools::Absolute(GetAnalysisToolsArgumentList(all_argument)[0]));
 
 		else if(operation == "AngleAddition")
 			results.push_back(AnalysisTools::AngleAddition(ParseAKROSDVariable(arguments[0], iterators_to_use[argument_correspondences[0]]), ParseAKROSDVariable(arguments[1], iterators_to_use[argument_correspondences[1]])));
@@ -1223,13 +1682,13 @@ std::vector<float> Dileptons::GetVectorOfParseResults(AKROSD operation, std::vec
 			results.push_back(AnalysisTools::DeltaR(ParseAKROSDVariable(arguments[0], iterators_to_use[argument_correspondences[0]]), ParseAKROSDVariable(arguments[1], iterators_to_use[argument_correspondences[1]]), ParseAKROSDVariable(arguments[2], iterators_to_use[argument_correspondences[2]]), ParseAKROSDVariable(arguments[3], iterators_to_use[argument_correspondences[3]])));
 
 		else if(operation == "Maximum")
-			results.push_back(AnalysisTools::Maximum(GetAnalysisToolsArgumentList(arguments[0].ReplaceAll("-all", ""))));
+			results.push_back(AnalysisTools::Maximum(GetAnalysisToolsArgumentList(all_argument)));
 
 		else if(operation == "Minimum")
-			results.push_back(AnalysisTools::Minimum(GetAnalysisToolsArgumentList(arguments[0].ReplaceAll("-all", ""))));
+			results.push_back(AnalysisTools::Minimum(GetAnalysisToolsArgumentList(all_argument)));
 
 		else if(operation == "Sum")
-			results.push_back(AnalysisTools::Sum(GetAnalysisToolsArgumentList(arguments[0].ReplaceAll("-all", ""))));
+			results.push_back(AnalysisTools::Sum(GetAnalysisToolsArgumentList(all_argument)));
 
 		else
 			return results;
@@ -1540,7 +1999,7 @@ bool Dileptons::ParseAKROSDCombinedRegularStatements(AKROSD string, Label label)
 	// filling event and object counts for the combined string in parantheses 
 
 	if(label == "event") kEventCountCache[kSampleIterator][kSelectionIterator][parenthesized_string] += 1;
-	else if(label != "") kObjectCountCache[kSampleIterator][label][parenthesized_string] += 1;
+	else if(label != "" && kKinematicVariationIterator == 0) kObjectCountCache[kSampleIterator][label][parenthesized_string] += 1;
 
 	return true;
 
@@ -1584,6 +2043,8 @@ bool Dileptons::ParseAKROSDRegularStatement(AKROSD statement, Label label){
 	if(statement.Length() == 0) return true;
 	if(statement == "true" ) return true;
 	if(statement == "false") return false;
+
+	kProfiler -> StartClause(statement);
 	
 	// We parse a regular statement, i.e. a statement that has a variable, an operation
 	// and a value in this order from left to right
@@ -1639,7 +2100,7 @@ bool Dileptons::ParseAKROSDRegularStatement(AKROSD statement, Label label){
 	if(Tools::FindElementInMapByKey(cDefinedVariableDefinitions, value)){ 
 		if(RecreateDefinedVariable(value)){
 			//std::cout << "parsing at point (1) " << value << std::endl;
-			kDefinedVariables[value] = ParseVariableDefinition(cDefinedVariableDefinitions[value]);
+			ParseDefinedVariable(value);
 		}
 		if(kDefinedVariables[value].size() > 0) 
 			fvalue = kDefinedVariables[value][0];
@@ -1657,9 +2118,11 @@ bool Dileptons::ParseAKROSDRegularStatement(AKROSD statement, Label label){
 
 	if(return_value && label != "") {
 		if(label == "event") kEventCountCache[kSampleIterator][kSelectionIterator][statement] += 1;
-		else                 kObjectCountCache[kSampleIterator][label][statement] += 1;
+		else if(kKinematicVariationIterator == 0) kObjectCountCache[kSampleIterator][label][statement] += 1;
 	}
 
+	kProfiler -> Stop();
+
 	return return_value;
 	
 }
@@ -1683,7 +2146,7 @@ bool Dileptons::ParseAKROSDString(AKROSD string, Label label){
 	// string is empty => return true
 	if(string.Length() == 0) {
 		if(label == "event") kEventCountCache[kSampleIterator][kSelectionIterator]["no selection"] += 1;
-		else if(label != "") kObjectCountCache[kSampleIterator][label]["no selection"] += 1;
+		else if(label != "" && kKinematicVariationIterator == 0) kObjectCountCache[kSampleIterator][label]["no selection"] += 1;
 		return true;
 	}
 
@@ -1767,11 +2230,12 @@ float Dileptons::ParseAKROSDVariable(AKROSD variable_name, int object_index, int
 			if(object_index == -1) object_index = kJetIterator;
 			if     (variable == "BSTAR") return (float) JetBetaStar   -> at(kKinematicObjects[object][object_index]);
 			else if(variable == "BTAG" ) return (float) JetCSVBTag    -> at(kKinematicObjects[object][object_index]);
+			else if(variable == "CLEAN") return Tools::ConvertBoolToFloatAlternatively(IsCleanJet(kKinematicObjects[object][object_index]));
 			else if(variable == "E"    ) return (float) JetEnergy     -> at(kKinematicObjects[object][object_index]);
 			else if(variable == "ETA"  ) return (float) JetEta        -> at(kKinematicObjects[object][object_index]);
 			else if(variable == "PHI"  ) return (float) JetPhi        -> at(kKinematicObjects[object][object_index]);
 			else if(variable == "PFL"  ) return (float) JetPartonFlav -> at(kKinematicObjects[object][object_index]);
-			else if(variable == "PT"   ) return (float) (cJetEnergyCorrection == 1 ? JetPt -> at(kKinematicObjects[object][object_index]) : JetRawPt -> at(kKinematicObjects[object][object_index]));
+			else if(variable == "PT"   ) return GetJetPt(kKinematicObjects[object][object_index]);
 		}
 	
 		else if(object_type.Index("muon") > -1){
@@ -1806,7 +2270,7 @@ float Dileptons::ParseAKROSDVariable(AKROSD variable_name, int object_index, int
 			// not parsed yet
 			if(RecreateDefinedVariable(variable_name)){
 				//std::cout << "parsing at point (0) " << variable_name << std::endl;
-				kDefinedVariables[variable_name] = ParseVariableDefinition(cDefinedVariableDefinitions[variable_name], object_index);
+				ParseDefinedVariable(variable_name, object_index);
 			}
 		
 			if     (look_for_way >=  1) return AnalysisTools::Maximum(kDefinedVariables[variable_name]);
@@ -1852,15 +2316,19 @@ float Dileptons::ParseAKROSDVariable(AKROSD variable_name, int object_index, int
 			// we could parse this object first, and then check if the tree entry is
 			// part of that object; i mean, we could do it, but since we do not save
 			// the tree index of the selected objects, we cannot do it here
-			if(ParseObjectSelection(cObjectSelectionDefinitions[variable_name], "")) return 1.0;
+			kProfiler -> StartDefinition("o", cObjectSelectionDefinitions[variable_name], variable_name);
+			bool selected = ParseObjectSelection(cObjectSelectionDefinitions[variable_name], "");
+			kProfiler -> Stop();
+
+			if(selected) return 1.0;
 			else return 0.0;
 		}
 
 
 		// event variables
 
-		if     (variable == "MET"    ) return (float) (cJetEnergyCorrection == 1) ? pfMET1 : pfMET;
-		else if(variable == "METPHI" ) return (float) (cJetEnergyCorrection == 1) ? pfMET1Phi : pfMETPhi;
+		if     (variable == "MET"    ) return GetMET();
+		else if(variable == "METPHI" ) return GetMETPhi();
 		else if(variable == "MU17"   ) return (float) HLT_MU17;
 		else if(variable == "MU24"   ) return (float) HLT_MU24;
 		else if(variable == "MU40"   ) return (float) HLT_MU40;
@@ -1957,8 +2425,7 @@ void Dileptons::CollectElectrons(Label object_name, AKROSD object_selection){
   	return: none
   	*/
 
-	std::vector<int> vector;
-	kKinematicObjects.insert(std::pair<Label, std::vector<int> >(object_name, vector));
+	kKinematicObjects.insert(std::pair<Label, ArenaIntVector>(object_name, ArenaIntVector(kArena)));
 
 	for(kElectronIterator = 0; kElectronIterator < ElPt -> size(); ++kElectronIterator)
 		if(ParseObjectSelection(object_selection, object_name))
@@ -1975,8 +2442,7 @@ void Dileptons::CollectJets(Label object_name, AKROSD object_selection){
   	return: none
   	*/
 	
-	std::vector<int> vector;
-	kKinematicObjects.insert(std::pair<Label, std::vector<int> >(object_name, vector));
+	kKinematicObjects.insert(std::pair<Label, ArenaIntVector>(object_name, ArenaIntVector(kArena)));
 
 	for(kJetIterator = 0; kJetIterator < JetPt -> size(); ++kJetIterator)
 		if(ParseObjectSelection(object_selection, object_name))
@@ -1995,12 +2461,16 @@ void Dileptons::CollectKinematicObjects(Label object_name, AKROSD object_selecti
 
 	TString object_type = GetKinematicObjectTypeByLabel(object_name);
 
+	kProfiler -> StartDefinition("o", object_selection, object_name);
+
 	if     (object_type.Index("electron") > -1) CollectElectrons(object_name, object_selection);
 	else if(object_type.Index("jet"     ) > -1) CollectJets     (object_name, object_selection);
 	else if(object_type.Index("muon"    ) > -1) CollectMuons    (object_name, object_selection);
 	else if(object_type.Index("photon"  ) > -1) CollectPhotons  (object_name, object_selection);
 	else if(object_type.Index("tau"     ) > -1) CollectTaus     (object_name, object_selection);
 
+	kProfiler -> Stop();
+
 }
 
 
@@ -2028,8 +2498,7 @@ void Dileptons::CollectMuons(Label object_name, AKROSD object_selection){
   	return: none
   	*/
 
-	std::vector<int> vector;
-	kKinematicObjects.insert(std::pair<Label, std::vector<int> >(object_name, vector));
+	kKinematicObjects.insert(std::pair<Label, ArenaIntVector>(object_name, ArenaIntVector(kArena)));
 
 	for(kMuonIterator = 0; kMuonIterator < MuPt -> size(); ++kMuonIterator)
 		if(ParseObjectSelection(object_selection, object_name))
@@ -2046,8 +2515,7 @@ void Dileptons::CollectPhotons(Label object_name, AKROSD object_selection){
   	return: none
   	*/
 	
-//	std::vector<int> vector;
-//	kKinematicObjects.insert(std::pair<Label, std::vector<int> >(object_name, vector));
+//	kKinematicObjects.insert(std::pair<Label, ArenaIntVector>(object_name, ArenaIntVector(kArena)));
 //
 //	for(kPhotonIterator = 0; kPhotonIterator < PhPt -> size(); ++kPhotonIterator)
 //		if(ParseObjectSelection(object_selection, object_name))
@@ -2064,8 +2532,7 @@ void Dileptons::CollectTaus(Label object_name, AKROSD object_selection){
   	return: none
   	*/
 	
-//	std::vector<int> vector;
-//	kKinematicObjects.insert(std::pair<Label, std::vector<int> >(object_name, vector));
+//	kKinematicObjects.insert(std::pair<Label, ArenaIntVector>(object_name, ArenaIntVector(kArena)));
 //
 //	for(kTauIterator = 0; kTauIterator < TauPt -> size(); ++kTauIterator)
 //		if(ParseObjectSelection(object_selection, object_name))
@@ -2136,6 +2603,124 @@ void Dileptons::CountSelectedKinematicObjects(){
 *****************************************************************************/
 
 
+//____________________________________________________________________________
+void Dileptons::ApplyKinematicVariation(int variation){
+	/*
+  	derives the jet pt and the MET of a kinematic variation from the nominal
+  	values of the event into side buffers, the tree variables themselves stay
+  	untouched; the MET is corrected by the change of every jet in the
+  	transverse plane; variation 0 switches back to the nominal values; data
+  	is not varied, its buffers keep the nominal values; JER smears the
+  	simulated resolution up to SF times it, the random numbers depend on the
+  	event, the variation and the jet only
+  	parameters: variation (0 for nominal, i > 0 for the i-th variation)
+  	return: none
+  	*/
+
+	kKinematicVariationIterator = variation;
+
+	if(variation <= 0 || variation > kKinematicVariations.size()) {
+		kKinematicVariationIterator = 0;
+		return;
+	}
+
+	KinematicVariation * definition = &kKinematicVariations[variation - 1];
+
+	float nominal_met    = (cJetEnergyCorrection == 1) ? pfMET1    : pfMET;
+	float nominal_metphi = (cJetEnergyCorrection == 1) ? pfMET1Phi : pfMETPhi;
+	float met_x          = nominal_met * cos(nominal_metphi);
+	float met_y          = nominal_met * sin(nominal_metphi);
+
+	kVariedJetPt.resize(JetPt -> size());
+
+	ULong64_t key   = Bootstrap::Hash(Bootstrap::GetEventKey(Run, Lumi, Event) ^ (ULong64_t) variation);
+	float smearing  = sqrt(std::max(definition -> parameter * definition -> parameter - 1.f, 0.f));
+
+	for(int i = 0; i < JetPt -> size(); ++i){
+
+		float nominal_pt = (cJetEnergyCorrection == 1) ? JetPt -> at(i) : JetRawPt -> at(i);
+		float factor     = 1.;
+
+		if     (kIsData) factor = 1.;
+		else if(definition -> type == "JES") factor = 1. + definition -> parameter;
+		else if(definition -> type == "JER") factor = 1. + smearing * GetJetResolution(nominal_pt, JetEta -> at(i)) / nominal_pt * Bootstrap::GetGaussian(key, i);
+
+		kVariedJetPt[i] = nominal_pt * factor;
+
+		met_x -= (kVariedJetPt[i] - nominal_pt) * cos(JetPhi -> at(i));
+		met_y -= (kVariedJetPt[i] - nominal_pt) * sin(JetPhi -> at(i));
+	}
+
+	kVariedMET    = sqrt(met_x * met_x + met_y * met_y);
+	kVariedMETPhi = atan2(met_y, met_x);
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::CleanJets(){
+	/*
+  	builds the jet cleaning table of the event from the lepton objects given in
+  	CleaningObjects, e.g. LE,LM; jet definitions then only look up the mask via
+  	J.CLEAN instead of searching the closest jet of every lepton for every jet
+  	parameters: none
+  	return: none
+  	*/
+
+	INSTRUMENT_TIMER(kVerbose, "CleanJets");
+
+	std::vector<Label> & objects = kCleaningObjects;
+	std::vector<float> eta;
+	std::vector<float> phi;
+
+	for(int i = 0; i < objects.size(); ++i){
+
+		if(FindKinematicObjects(objects[i]) == -1){
+			CollectKinematicObjects(objects[i], cObjectSelectionDefinitions[objects[i]]);
+			CountKinematicObjects(objects[i]);
+		}
+
+		TString object_type = GetKinematicObjectTypeByLabel(objects[i]);
+
+		for(int j = 0; j < kNumberOfKinematicObjects[objects[i]]; ++j){
+			if     (object_type.Index("electron") > -1) { eta.push_back(ElEta -> at(kKinematicObjects[objects[i]][j])); phi.push_back(ElPhi -> at(kKinematicObjects[objects[i]][j])); }
+			else if(object_type.Index("muon"    ) > -1) { eta.push_back(MuEta -> at(kKinematicObjects[objects[i]][j])); phi.push_back(MuPhi -> at(kKinematicObjects[objects[i]][j])); }
+		}
+	}
+
+	FillJetCleaningTable(eta, phi, cCleaningDeltaR);
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::ComputeEventWeights(float sample_weight, float event_weight){
+	/*
+  	computes the weights of the event, the nominal one first and then one per
+  	weight variation, i.e. the sample weight times the product of the branches
+  	given in the definition of the variation; if bootstrap replicas are
+  	requested, their weights (the nominal weight times a Poisson(1) number
+  	seeded by the event) are appended after the variations
+  	parameters: sample_weight, event_weight (the nominal weight)
+  	return: none
+  	*/
+
+	kEventWeights.resize(kWeightFactors.size() + 1);
+	kEventWeights[0] = event_weight;
+
+	for(int i = 0; i < kWeightFactors.size(); ++i){
+		float weight = sample_weight;
+		for(int j = 0; j < kWeightFactors[i].size(); ++j)
+			weight *= *kWeightFactors[i][j];
+		kEventWeights[i + 1] = weight;
+	}
+
+	if(cBootstrapReplicas > 0)
+		Bootstrap::GetReplicaWeights(Run, Lumi, Event, cBootstrapReplicas, event_weight, kEventWeights);
+
+}
+
+
 //____________________________________________________________________________
 float Dileptons::ComputeMT(Label lepton_type, int lepton_iterator){
 	/*
@@ -2151,7 +2736,7 @@ float Dileptons::ComputeMT(Label lepton_type, int lepton_iterator){
 	else if(lepton_type == "electron") lepton.SetPtEtaPhiM( ElPt -> at(lepton_iterator), ElEta -> at(lepton_iterator), ElPhi -> at(lepton_iterator), 0.005);
 	else                               kVerbose -> ErrorAndExit();
 	
-	met.SetPtEtaPhiM((cJetEnergyCorrection == 1) ? pfMET1 : pfMET, 0., (cJetEnergyCorrection == 1) ? pfMET1Phi : pfMETPhi, 0.);
+	met.SetPtEtaPhiM(GetMET(), 0., GetMETPhi(), 0.);
 
 	float ET_lepton = TMath::Sqrt(lepton.M2() + lepton.Perp2());
 
@@ -2160,6 +2745,42 @@ float Dileptons::ComputeMT(Label lepton_type, int lepton_iterator){
 }
 
 
+//____________________________________________________________________________
+void Dileptons::FillJetCleaningTable(const std::vector<float> & lepton_eta, const std::vector<float> & lepton_phi, float delta_r){
+	/*
+  	finds the closest jet and its distance for every given lepton and removes
+  	this jet from the mask of clean jets if it is closer than delta_r; this is
+  	done once per event and is linear in the number of leptons times jets
+  	parameters: lepton_eta, lepton_phi, delta_r
+  	return: none
+  	*/
+
+	kJetCleaningTable.clear();
+	kCleanJets.assign(JetPt -> size(), true);
+
+	for(int i = 0; i < lepton_eta.size(); ++i){
+
+		JetCleaning cleaning;
+		cleaning.jet     = -1;
+		cleaning.delta_r = 99.;
+
+		for(int j = 0; j < JetPt -> size(); ++j){
+			float dr = AnalysisTools::DeltaR(lepton_eta[i], JetEta -> at(j), lepton_phi[i], JetPhi -> at(j));
+			if(dr < cleaning.delta_r) {
+				cleaning.jet     = j;
+				cleaning.delta_r = dr;
+			}
+		}
+
+		kJetCleaningTable.push_back(cleaning);
+		if(cleaning.jet > -1 && cleaning.delta_r < delta_r) kCleanJets[cleaning.jet] = false;
+	}
+
+	kJetCleaningDone = true;
+
+}
+
+
 //____________________________________________________________________________
 int Dileptons::FindKinematicObjects(Label object_name){
 	/*
@@ -2178,6 +2799,163 @@ int Dileptons::FindKinematicObjects(Label object_name){
 }
 
 
+//____________________________________________________________________________
+Float_t * Dileptons::GetWeightBranch(Label branch_name){
+	/*
+  	returns the address of a weight branch of the tree, such that the weights
+  	of the variations can be computed without looking up the branch names
+  	parameters: branch_name
+  	return: address of the branch variable (if it is a weight branch), 0 (else)
+  	*/
+
+	if     (branch_name == "PUWeight"  ) return &PUWeight;
+	else if(branch_name == "PUWeightUp") return &PUWeightUp;
+	else if(branch_name == "PUWeightDn") return &PUWeightDn;
+	else if(branch_name == "GenWeight" ) return &GenWeight;
+
+	return 0;
+
+}
+
+
+//____________________________________________________________________________
+float Dileptons::GetJetPt(int jet_index){
+	/*
+  	returns the pt of a jet, either of the kinematic variation that is applied
+  	or the nominal one with or without jet energy correction
+  	parameters: jet_index (index of the jet in the tree)
+  	return: jet pt
+  	*/
+
+	if(kKinematicVariationIterator > 0) return kVariedJetPt[jet_index];
+
+	return (cJetEnergyCorrection == 1) ? JetPt -> at(jet_index) : JetRawPt -> at(jet_index);
+
+}
+
+
+//____________________________________________________________________________
+float Dileptons::GetJetResolution(float pt, float eta){
+	/*
+  	returns the absolute jet pt resolution in simulation, parametrized in bins
+  	of eta as in the jet smearing of the fake rate estimation
+  	parameters: pt, eta
+  	return: resolution
+  	*/
+
+	float N = 2.95397, S = 0.11619, m = 0.96086;
+
+	if     (fabs(eta) < 0.5) { N =  3.96859; S = 0.18348; m = 0.62627; }
+	else if(fabs(eta) < 1. ) { N =  3.55226; S = 0.24026; m = 0.52571; }
+	else if(fabs(eta) < 1.5) { N =  4.54826; S = 0.22652; m = 0.58963; }
+	else if(fabs(eta) < 2. ) { N =  4.62622; S = 0.23664; m = 0.48738; }
+	else if(fabs(eta) < 2.5) { N =  2.53324; S = 0.34306; m = 0.28662; }
+	else if(fabs(eta) < 3. ) { N = -3.33814; S = 0.73360; m = 0.08264; }
+
+	return sqrt((N * fabs(N)) + (S * S) * pow(pt, m + 1));
+
+}
+
+
+//____________________________________________________________________________
+float Dileptons::GetMET(){
+	/*
+  	returns the MET, either of the kinematic variation that is applied or the
+  	nominal one with or without jet energy correction
+  	parameters: none
+  	return: MET
+  	*/
+
+	if(kKinematicVariationIterator > 0) return kVariedMET;
+
+	return (cJetEnergyCorrection == 1) ? pfMET1 : pfMET;
+
+}
+
+
+//____________________________________________________________________________
+float Dileptons::GetMETPhi(){
+	/*
+  	returns the phi of the MET, either of the kinematic variation that is
+  	applied or the nominal one with or without jet energy correction
+  	parameters: none
+  	return: phi of the MET
+  	*/
+
+	if(kKinematicVariationIterator > 0) return kVariedMETPhi;
+
+	return (cJetEnergyCorrection == 1) ? pfMET1Phi : pfMETPhi;
+
+}
+
+
+//____________________________________________________________________________
+bool Dileptons::IsCleanJet(int jet_index){
+	/*
+  	checks if a jet is clean, i.e. if it is not the closest jet to any of the
+  	leptons in the cleaning table; the table is built at the first call in the
+  	event
+  	parameters: jet_index (index of the jet in the tree)
+  	return: true (if jet is clean), false (else)
+  	*/
+
+	if(!kJetCleaningDone) CleanJets();
+
+	return kCleanJets[jet_index];
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::ParseDefinedVariable(Label label, int object_index){
+	/*
+	parses a defined event variable and stores its values; a new entry of the
+	map is constructed on the arena of the event, the allocator of a vector is
+	not exchanged by swapping or assigning it
+	parameters: label, object_index (index of the object fixed by *, if any)
+	return: none
+	*/
+
+	ArenaFloatVector values = ParseVariableDefinition(cDefinedVariableDefinitions[label], object_index);
+
+	std::map<Label, ArenaFloatVector>::iterator entry = kDefinedVariables.find(label);
+	if(entry == kDefinedVariables.end())
+		entry = kDefinedVariables.insert(std::pair<Label, ArenaFloatVector>(label, ArenaFloatVector(ArenaAllocator<float>(kArena)))).first;
+	entry -> second.assign(values.begin(), values.end());
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::ReadDerivedColumns(){
+	/*
+	reads the objects and defined variables of the current entry from the
+	columns of earlier runs; only the nominal event is read, the kinematic
+	variations change the objects
+	parameters: none
+	return: none
+	*/
+
+	if(!kColumnStore -> IsOpen() || kKinematicVariationIterator != 0) return;
+
+	kColumnStore -> ReadEntry(kRootTree -> GetReadEntry());
+
+	for(int i = 0; i < kColumnStore -> GetNumberOfColumns(); ++i){
+		if(!kColumnStore -> IsPrecomputed(i)) continue;
+
+		if(kColumnStore -> IsObject(i)) {
+			std::vector<int> * indices = kColumnStore -> GetIndices(i);
+			kKinematicObjects.insert(std::pair<Label, ArenaIntVector>(kColumnStore -> GetLabel(i), ArenaIntVector(indices -> begin(), indices -> end(), kArena)));
+		}
+		else {
+			std::vector<float> * values = kColumnStore -> GetValues(i);
+			kDefinedVariables.insert(std::pair<Label, ArenaFloatVector>(kColumnStore -> GetLabel(i), ArenaFloatVector(values -> begin(), values -> end(), kArena)));
+		}
+	}
+
+}
+
+
 //____________________________________________________________________________
 bool Dileptons::RecreateDefinedVariable(Label label){
 	/*
@@ -2222,6 +3000,100 @@ void Dileptons::ResetKinematicObjects(){
 	
 	kKinematicObjects        .clear();
 	kNumberOfKinematicObjects.clear();
+	kJetCleaningDone         = false;
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::SetKinematicVariations(){
+	/*
+  	translates the kinematic variations of the configuration file (label 'k'),
+  	e.g. JES:0.05 or JER:1.1, into their type and parameter; every variation
+  	re-evaluates the object and event selections of the event
+  	parameters: none
+  	return: none
+  	*/
+
+	kKinematicVariationNames.clear();
+	kKinematicVariations    .clear();
+
+	for(std::map<Label, TString>::iterator i = cKinematicVariationDefinitions.begin(); i != cKinematicVariationDefinitions.end(); ++i){
+
+		std::vector<TString> components = Tools::ExplodeTString(i -> second, ":");
+		if(components.size() != 2 || (components[0] != "JES" && components[0] != "JER")) kVerbose -> ErrorAndExit(16);
+
+		KinematicVariation variation;
+		variation.type      = components[0];
+		variation.parameter = components[1].Atof();
+
+		kKinematicVariationNames.push_back(i -> first);
+		kKinematicVariations    .push_back(variation);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::SetWeightVariations(){
+	/*
+  	translates the weight definitions of the configuration file (label 'w'),
+  	e.g. PUWeightUp*GenWeight, into lists of branch addresses; every variation
+  	gets its own bin array in all histograms and is filled in the same loop
+  	parameters: none
+  	return: none
+  	*/
+
+	kWeightNames  .clear();
+	kWeightFactors.clear();
+	kEventWeights .assign(1, 1.);
+
+	for(std::map<Label, TString>::iterator i = cWeightDefinitions.begin(); i != cWeightDefinitions.end(); ++i){
+
+		std::vector<TString> branches = Tools::ExplodeTString(i -> second, "*");
+		std::vector<Float_t*> factors;
+
+		for(int j = 0; j < branches.size(); ++j){
+			Float_t * factor = GetWeightBranch(branches[j].Strip(TString::kBoth, ' '));
+			if(factor == 0) kVerbose -> ErrorAndExit(15);
+			factors.push_back(factor);
+		}
+
+		kWeightNames  .push_back(i -> first);
+		kWeightFactors.push_back(factors);
+	}
+
+	kEventWeights.resize(kWeightFactors.size() + 1, 1.);
+
+}
+
+
+//____________________________________________________________________________
+void Dileptons::WriteDerivedColumns(){
+	/*
+	gives the objects and defined variables of the current entry to the columns
+	computed in this run; defined variables are evaluated here even if no
+	selection of this run needs them, such that the column is complete
+	parameters: none
+	return: none
+	*/
+
+	if(!kColumnStore -> IsOpen() || kKinematicVariationIterator != 0) return;
+
+	for(int i = 0; i < kColumnStore -> GetNumberOfColumns(); ++i){
+		if(kColumnStore -> IsPrecomputed(i)) continue;
+
+		Label label = kColumnStore -> GetLabel(i);
+
+		if(kColumnStore -> IsObject(i))
+			kColumnStore -> GetIndices(i) -> assign(kKinematicObjects[label].begin(), kKinematicObjects[label].end());
+		else {
+			if(RecreateDefinedVariable(label)) ParseDefinedVariable(label);
+			kColumnStore -> GetValues(i) -> assign(kDefinedVariables[label].begin(), kDefinedVariables[label].end());
+		}
+	}
+
+	kColumnStore -> FillEntry(kRootTree -> GetReadEntry());
 
 }
 
@@ -2240,7 +3112,7 @@ void Dileptons::ResetKinematicObjects(){
 
 
 //____________________________________________________________________________
-std::vector<float> Dileptons::ParseVariableDefinition(AKROSD variable_definition, int object_index){
+ArenaFloatVector Dileptons::ParseVariableDefinition(AKROSD variable_definition, int object_index){
 	/*
 	parses the definition of a defined event variable
 	parameters: AKROSD string
@@ -2248,7 +3120,7 @@ std::vector<float> Dileptons::ParseVariableDefinition(AKROSD variable_definition
 	*/
 
 
-	std::vector<float> results;
+	ArenaFloatVector results(kArena);
 	AKROSD delimiter;
 
 
@@ -2256,16 +3128,19 @@ std::vector<float> Dileptons::ParseVariableDefinition(AKROSD variable_definition
 
 	if(variable_definition.Length() == 0) return results;
 
+	kProfiler -> StartDefinition("d", variable_definition);
+
 
 	// calling AnalysisTools
 
 	if(variable_definition.Index("%AT:") > -1){
 
 		Ssiz_t position = variable_definition.Index("%AT:");
-		std::vector<AKROSD> components;
-		std::vector<AKROSD> arguments;
+		AKROSD call = variable_definition(position + 4, variable_definition.Length() - position - 4);
+		ArenaTStringVector components(kArena);
+		ArenaTStringVector arguments(kArena);
 
-		components = Tools::ExplodeTString(variable_definition(position + 4, variable_definition.Length() - position - 4), ":");
+		Tools::ExplodeTString(call, ":", components);
 		AKROSD function = components[0];
 
 		for(int i = 1; i < components.size(); ++i)
@@ -2280,7 +3155,7 @@ std::vector<float> Dileptons::ParseVariableDefinition(AKROSD variable_definition
 
 	else if(variable_definition.First("+") > -1 || variable_definition.First("-") > -1){
 
-		std::vector<AKROSD> observables = GetAKROSDStatements(variable_definition, "+", "-");
+		ArenaTStringVector observables = GetAKROSDStatements(variable_definition, "+", "-");
 
 		if(variable_definition.First("+") != -1) delimiter = "+";
 		else delimiter = "-";
@@ -2292,6 +3167,8 @@ std::vector<float> Dileptons::ParseVariableDefinition(AKROSD variable_definition
 	//std::cout << "returning.." << std::endl;
 	//DUMPVECTOR(results);
 
+	kProfiler -> Stop();
+
 	return results;
 }
 
@@ -2306,6 +3183,8 @@ void Dileptons::PrepareEventSelection(){
   	return: none
   	*/
 
+	INSTRUMENT_TIMER(kVerbose, "PrepareEventSelection");
+
 
 	// reset the maps of the kinematic objects and the defined event variables
 	// which are still filled from the old event, i.e. we prepare for the new event
@@ -2313,6 +3192,16 @@ void Dileptons::PrepareEventSelection(){
 	ResetKinematicObjects();
 
 
+	// the vectors of the old event are gone, so the memory of the arena can be
+	// handed out again
+	kArena -> Reset();
+
+
+	// the columns of earlier runs are read before anything is collected, the
+	// objects and defined variables in them are not evaluated again
+	ReadDerivedColumns();
+
+
 	// we collect and count all basic kinematic objects  
 	CollectBasicKinematicObjects();
 	CountBasicKinematicObjects();
@@ -2322,6 +3211,10 @@ void Dileptons::PrepareEventSelection(){
 	CollectSelectedKinematicObjects();
 	CountSelectedKinematicObjects();
 
+
+	// the columns computed in this run get the values of this event
+	WriteDerivedColumns();
+
 }
 
 
@@ -2335,7 +3228,13 @@ bool Dileptons::ParseEventSelection(AKROSD event_selection){
 	return: true (if event is selected), false (else)
 	*/ 
 
-	return ParseAKROSDString(event_selection, "event");
+	INSTRUMENT_TIMER(kVerbose, "ParseEventSelection");
+
+	kProfiler -> StartDefinition("e", event_selection);
+	bool selected = ParseAKROSDString(event_selection, "event");
+	kProfiler -> Stop();
+
+	return selected;
 
 }
 
@@ -0,0 +1,595 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/head/MicroBenchmarks.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CODE                                       **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+MicroBenchmarks::MicroBenchmarks(TString configuration_file, int number_of_events, unsigned int seed){
+	/*
+	constructs the MicroBenchmarks Class, which measures the cost of single
+	parts of the AKROSD parser on fixed synthetic events; the configuration
+	file is loaded and used like in production, but no samples are needed
+	parameters: configuration_file, number_of_events, seed
+	return: none
+	*/
+
+	kVerbose -> Class("MicroBenchmarks");
+	Initialize(number_of_events, seed);
+	LoadConfigurationFile(configuration_file);
+	UseConfigurationVariables();
+
+}
+
+
+//____________________________________________________________________________
+MicroBenchmarks::~MicroBenchmarks(){
+	/*
+	destructs the MicroBenchmarks Class
+	parameters: none
+	return: none
+	*/
+
+	for(int i = 0; i < kEvents.size(); ++i)
+		delete kEvents[i];
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::Initialize(int number_of_events, unsigned int seed){
+	/*
+	initializes the MicroBenchmarks Class, generates the synthetic events and
+	reserves the counters that the parser fills for one sample and one selection
+	parameters: number_of_events, seed
+	return: none
+	*/
+
+	kSampleIterator    = 0;
+	kSelectionIterator = 0;
+	kSink              = 0.;
+
+	kEventCountCache .assign(1, std::vector<std::map<AKROSD, int> >(1));
+	kObjectCountCache.assign(1, std::map<Label, std::map<AKROSD, int> >());
+
+	for(int i = 0; i < number_of_events; ++i){
+		SyntheticSample * event = new SyntheticSample(seed + i);
+		event -> GenerateEvent();
+		kEvents.push_back(event);
+	}
+
+	kTimerOverhead = GetTimerOverhead();
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::LoadEvent(int event){
+	/*
+	loads a synthetic event and collects the kinematic objects, such that every
+	measurement starts from the state of a fresh event in the event loop
+	parameters: event (index)
+	return: none
+	*/
+
+	kEvents[event] -> CopyEventTo(this);
+	PrepareEventSelection();
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::RunBenchmarks(int repetitions){
+	/*
+	runs all micro benchmarks, every one loops repetitions times over all events
+	parameters: repetitions
+	return: none
+	*/
+
+	kResults.clear();
+
+	BenchmarkPreparation(repetitions);
+	BenchmarkObjectSelections(repetitions);
+	BenchmarkDefinedVariables(repetitions);
+	BenchmarkEventSelections(repetitions);
+	BenchmarkVariables(repetitions);
+	BenchmarkNesting(repetitions);
+	BenchmarkAnalysisTools(repetitions);
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR MEASURING                                              **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::BenchmarkAnalysisTools(int repetitions){
+	/*
+	measures the AnalysisTools functions on the objects of the synthetic events,
+	DeltaR for every pair of jets and muons, Maximum and Sum on the jet pts
+	parameters: repetitions
+	return: none
+	*/
+
+	long evaluations[3] = {0, 0, 0};
+	double times[3]     = {0., 0., 0.};
+	double start;
+	float sink = 0.;
+
+	for(int r = 0; r < repetitions; ++r){
+		for(int e = 0; e < kEvents.size(); ++e){
+
+			kEvents[e] -> CopyEventTo(this);
+
+			start = Benchmarks::GetTime();
+			for(int i = 0; i < JetPt -> size(); ++i)
+				for(int j = 0; j < MuPt -> size(); ++j)
+					sink += AnalysisTools::DeltaR(JetEta -> at(i), MuEta -> at(j), JetPhi -> at(i), MuPhi -> at(j));
+			times[0] += Benchmarks::GetTime() - start - kTimerOverhead;
+			evaluations[0] += JetPt -> size() * MuPt -> size();
+
+			start = Benchmarks::GetTime();
+			sink += AnalysisTools::Maximum(*JetPt);
+			times[1] += Benchmarks::GetTime() - start - kTimerOverhead;
+			evaluations[1] += 1;
+
+			start = Benchmarks::GetTime();
+			sink += AnalysisTools::Sum(*JetPt);
+			times[2] += Benchmarks::GetTime() - start - kTimerOverhead;
+			evaluations[2] += 1;
+		}
+	}
+
+	kSink = sink;
+
+	AddResult("analysistools", "DeltaR" , "", evaluations[0], times[0]);
+	AddResult("analysistools", "Maximum", "", evaluations[1], times[1]);
+	AddResult("analysistools", "Sum"    , "", evaluations[2], times[2]);
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::BenchmarkDefinedVariables(int repetitions){
+	/*
+	measures the parsing of every defined event variable of the configuration,
+	both the full ParseVariableDefinition and, for AnalysisTools calls, only
+	GetVectorOfParseResults; variables fixing an object with * are evaluated
+	for the first such object
+	parameters: repetitions
+	return: none
+	*/
+
+	for(std::map<Label, AKROSD>::iterator i = cDefinedVariableDefinitions.begin(); i != cDefinedVariableDefinitions.end(); ++i){
+
+		AKROSD definition = i -> second;
+		long evaluations  = 0;
+		double times[2]   = {0., 0.};
+		double start;
+
+
+		// the object fixed by *, if any
+
+		Label fixed_object = "";
+		if(definition.Index("*") > -1) {
+			fixed_object = definition(definition.Index("*") + 1, definition.Length());
+			if(fixed_object.First('.') > -1) fixed_object = fixed_object(0, fixed_object.First('.'));
+		}
+
+
+		// the arguments of the AnalysisTools call, split beforehand
+
+		AKROSD function = "";
+		ArenaTStringVector arguments;
+		if(definition.Index("%AT:") > -1) {
+			Ssiz_t position = definition.Index("%AT:");
+			std::vector<AKROSD> components = Tools::ExplodeTString(definition(position + 4, definition.Length() - position - 4), ":");
+			function = components[0];
+			for(int j = 1; j < components.size(); ++j)
+				arguments.push_back(components[j]);
+		}
+
+
+		for(int r = 0; r < repetitions; ++r){
+			for(int e = 0; e < kEvents.size(); ++e){
+
+				LoadEvent(e);
+
+				int object_index = -1;
+				if(fixed_object != "") {
+					if(FindKinematicObjects(fixed_object) == -1){
+						CollectKinematicObjects(fixed_object, cObjectSelectionDefinitions[fixed_object]);
+						CountKinematicObjects(fixed_object);
+					}
+					if(kNumberOfKinematicObjects[fixed_object] == 0) continue;
+					object_index = 0;
+				}
+
+				start = Benchmarks::GetTime();
+				ParseVariableDefinition(definition, object_index);
+				times[0] += Benchmarks::GetTime() - start - kTimerOverhead;
+				++evaluations;
+
+				if(function == "") continue;
+
+				LoadEvent(e);
+
+				start = Benchmarks::GetTime();
+				GetVectorOfParseResults(function, arguments, object_index);
+				times[1] += Benchmarks::GetTime() - start - kTimerOverhead;
+			}
+		}
+
+		AddResult("definition", i -> first, definition, evaluations, times[0]);
+		if(function != "") AddResult("parseresults", i -> first, definition, evaluations, times[1]);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::BenchmarkEventSelections(int repetitions){
+	/*
+	measures every event selection of the configuration, as a whole with
+	ParseEventSelection and split into the steps of ParseAKROSDString, i.e.
+	if-then-else statements, ranges, brackets and the remaining combination of
+	regular statements
+	parameters: repetitions
+	return: none
+	*/
+
+	for(std::map<Label, AKROSD>::iterator i = cEventSelectionDefinitions.begin(); i != cEventSelectionDefinitions.end(); ++i){
+
+		long evaluations = 0;
+		double times[5]  = {0., 0., 0., 0., 0.};
+		double start;
+
+		for(int r = 0; r < repetitions; ++r){
+			for(int e = 0; e < kEvents.size(); ++e){
+
+				LoadEvent(e);
+
+				start = Benchmarks::GetTime();
+				ParseEventSelection(i -> second);
+				times[0] += Benchmarks::GetTime() - start - kTimerOverhead;
+
+				LoadEvent(e);
+
+				AKROSD string = i -> second;
+				string = string.ReplaceAll(" ", "");
+
+				start = Benchmarks::GetTime();
+				string = InterpretAKROSDIfThElStatements(string, "event");
+				times[1] += Benchmarks::GetTime() - start - kTimerOverhead;
+
+				start = Benchmarks::GetTime();
+				string = InterpretAKROSDRangeStatements(string, "event");
+				times[2] += Benchmarks::GetTime() - start - kTimerOverhead;
+
+				start = Benchmarks::GetTime();
+				string = InterpretAKROSDBrackets(string, "event");
+				times[3] += Benchmarks::GetTime() - start - kTimerOverhead;
+
+				start = Benchmarks::GetTime();
+				ParseAKROSDCombinedRegularStatements(string, "event");
+				times[4] += Benchmarks::GetTime() - start - kTimerOverhead;
+
+				++evaluations;
+			}
+		}
+
+		AddResult("event"         , i -> first, i -> second, evaluations, times[0]);
+		AddResult("event:ifthel"  , i -> first, i -> second, evaluations, times[1]);
+		AddResult("event:range"   , i -> first, i -> second, evaluations, times[2]);
+		AddResult("event:brackets", i -> first, i -> second, evaluations, times[3]);
+		AddResult("event:combined", i -> first, i -> second, evaluations, times[4]);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::BenchmarkNesting(int repetitions){
+	/*
+	measures ParseEventSelection on generated strings of growing nesting depth
+	and growing number of statements, using only basic objects and event
+	variables, such that it does not depend on the configuration
+	parameters: repetitions
+	return: none
+	*/
+
+	std::vector<std::pair<TString, AKROSD> > strings;
+	const char * statements[5] = {"MET<1000", "#J<99", "#M<99", "#E<99", "NVTX<99"};
+
+
+	// nesting depth 0 to 5
+
+	AKROSD nested = "#J<99";
+	for(int depth = 0; depth <= 5; ++depth){
+		if(depth > 0) nested = Form("(#M>%d|%s)", depth, nested.Data());
+		strings.push_back(std::make_pair(Form("depth_%d", depth), nested));
+	}
+
+
+	// 1 to 16 statements
+
+	for(int length = 1; length <= 16; length *= 2){
+		AKROSD combined = statements[0];
+		for(int j = 1; j < length; ++j)
+			combined += Form(",%s", statements[j % 5]);
+		strings.push_back(std::make_pair(Form("statements_%d", length), combined));
+	}
+
+
+	for(int i = 0; i < strings.size(); ++i){
+
+		long evaluations = 0;
+		double time = 0.;
+		double start;
+
+		for(int r = 0; r < repetitions; ++r){
+			for(int e = 0; e < kEvents.size(); ++e){
+				LoadEvent(e);
+				start = Benchmarks::GetTime();
+				ParseEventSelection(strings[i].second);
+				time += Benchmarks::GetTime() - start - kTimerOverhead;
+				++evaluations;
+			}
+		}
+
+		AddResult("nesting", strings[i].first, strings[i].second, evaluations, time);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::BenchmarkObjectSelections(int repetitions){
+	/*
+	measures every object selection of the configuration by collecting the
+	objects anew; one evaluation is the selection of one candidate object
+	parameters: repetitions
+	return: none
+	*/
+
+	for(std::map<Label, AKROSD>::iterator i = cObjectSelectionDefinitions.begin(); i != cObjectSelectionDefinitions.end(); ++i){
+
+		TString object_type = GetKinematicObjectTypeByLabel(i -> first);
+		long evaluations = 0;
+		double time = 0.;
+		double start;
+
+		for(int r = 0; r < repetitions; ++r){
+			for(int e = 0; e < kEvents.size(); ++e){
+
+				LoadEvent(e);
+				kKinematicObjects        .erase(i -> first);
+				kNumberOfKinematicObjects.erase(i -> first);
+
+				start = Benchmarks::GetTime();
+				CollectKinematicObjects(i -> first, i -> second);
+				time += Benchmarks::GetTime() - start - kTimerOverhead;
+
+				if     (object_type.Index("electron") > -1) evaluations += ElPt  -> size();
+				else if(object_type.Index("jet"     ) > -1) evaluations += JetPt -> size();
+				else if(object_type.Index("muon"    ) > -1) evaluations += MuPt  -> size();
+				else if(object_type.Index("photon"  ) > -1) evaluations += PhPt  -> size();
+				else if(object_type.Index("tau"     ) > -1) evaluations += TauPt -> size();
+			}
+		}
+
+		AddResult("object", i -> first, i -> second, evaluations, time);
+	}
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::BenchmarkPreparation(int repetitions){
+	/*
+	measures PrepareEventSelection, i.e. collecting and counting all basic and
+	selected kinematic objects of an event
+	parameters: repetitions
+	return: none
+	*/
+
+	long evaluations = 0;
+	double time = 0.;
+	double start;
+
+	for(int r = 0; r < repetitions; ++r){
+		for(int e = 0; e < kEvents.size(); ++e){
+			kEvents[e] -> CopyEventTo(this);
+			start = Benchmarks::GetTime();
+			PrepareEventSelection();
+			time += Benchmarks::GetTime() - start - kTimerOverhead;
+			++evaluations;
+		}
+	}
+
+	AddResult("preparation", "PrepareEventSelection", "", evaluations, time);
+
+}
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::BenchmarkVariables(int repetitions){
+	/*
+	measures ParseAKROSDVariable for variables of basic objects, event variables,
+	numbers of selected objects and defined event variables
+	parameters: repetitions
+	return: none
+	*/
+
+	std::vector<AKROSD> variables;
+	variables.push_back("M.PT");
+	variables.push_back("M.ETA");
+	variables.push_back("M.ISL");
+	variables.push_back("E.PT");
+	variables.push_back("E.ETA");
+	variables.push_back("J.PT");
+	variables.push_back("J.BTAG");
+	variables.push_back("MET");
+	variables.push_back("NVTX");
+
+	for(std::map<Label, AKROSD>::iterator i = cObjectSelectionDefinitions.begin(); i != cObjectSelectionDefinitions.end(); ++i)
+		variables.push_back("#" + i -> first);
+
+	for(std::map<Label, AKROSD>::iterator i = cDefinedVariableDefinitions.begin(); i != cDefinedVariableDefinitions.end(); ++i)
+		if(i -> second.Index("*") == -1) variables.push_back(i -> first);
+
+
+	for(int i = 0; i < variables.size(); ++i){
+
+		Label object = "";
+		if(variables[i].First('.') > -1) object = variables[i](0, variables[i].First('.'));
+
+		long evaluations = 0;
+		double time = 0.;
+		double start;
+
+		for(int r = 0; r < repetitions; ++r){
+			for(int e = 0; e < kEvents.size(); ++e){
+
+				LoadEvent(e);
+
+				// object variables are parsed for every object, others once
+				int number_of_objects = (object != "") ? kNumberOfKinematicObjects[object] : 1;
+
+				for(int j = 0; j < number_of_objects; ++j){
+					start = Benchmarks::GetTime();
+					ParseAKROSDVariable(variables[i], (object != "") ? j : -1);
+					time += Benchmarks::GetTime() - start - kTimerOverhead;
+					++evaluations;
+				}
+			}
+		}
+
+		AddResult("variable", variables[i], variables[i], evaluations, time);
+	}
+
+}
+
+
+//____________________________________________________________________________
+double MicroBenchmarks::GetTimerOverhead(){
+	/*
+	measures the time of two subsequent calls of the clock, which is subtracted
+	from every single measurement
+	parameters: none
+	return: overhead in seconds
+	*/
+
+	int calls = 100000;
+	double start, total = 0.;
+
+	for(int i = 0; i < calls; ++i){
+		start = Benchmarks::GetTime();
+		total += Benchmarks::GetTime() - start;
+	}
+
+	return total / calls;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR REPORTING                                              **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+void MicroBenchmarks::AddResult(TString group, TString name, AKROSD string, long evaluations, double time){
+	/*
+	adds the result of a measurement as one tab separated line to the report
+	parameters: group, name, string (the AKROSD string measured), evaluations,
+	            time (in seconds)
+	return: none
+	*/
+
+	double nanoseconds = (evaluations > 0 && time > 0.) ? 1.e9 * time / evaluations : 0.;
+
+	kResults.push_back(Form("%s\t%s\t%d\t%d\t%ld\t%.1f\n", group.Data(), name.Data(), string.Length(), GetNestingDepth(string), evaluations, nanoseconds));
+
+}
+
+
+//____________________________________________________________________________
+int MicroBenchmarks::GetNestingDepth(AKROSD string){
+	/*
+	returns the maximal number of brackets opened at the same time
+	parameters: string
+	return: nesting depth
+	*/
+
+	int depth = 0, maximum = 0;
+
+	for(int i = 0; i < string.Length(); ++i){
+		if(string[i] == '(') ++depth;
+		if(string[i] == ')') --depth;
+		if(depth > maximum) maximum = depth;
+	}
+
+	return maximum;
+
+}
+
+
+//____________________________________________________________________________
+TString MicroBenchmarks::PrintReport(){
+	/*
+	prints the results of all measurements
+	parameters: none
+	return: report
+	*/
+
+	TString report = "";
+	for(int i = 0; i < kResults.size(); ++i)
+		report += kResults[i];
+
+	return report;
+
+}
+
+
+//____________________________________________________________________________
+TString MicroBenchmarks::PrintReportHeader(){
+	/*
+	prints the header of the micro benchmark report; length is the length of
+	the AKROSD string, depth the nesting depth of its brackets
+	parameters: none
+	return: header line
+	*/
+
+	return "#group\tname\tlength\tdepth\tevaluations\tns/evaluation\n";
+
+}
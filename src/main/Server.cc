@@ -0,0 +1,500 @@
+/*****************************************************************************
+******************************************************************************
+******************************************************************************
+**                                                                          **
+** The Dileptons Analysis Framework                                         **
+**                                                                          **
+** Constantin Heidegger, CERN, Summer 2014                                  **
+**                                                                          **
+******************************************************************************
+******************************************************************************
+*****************************************************************************/
+
+
+#include "src/head/Server.hh"
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR RUNNING THE CODE                                       **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+Server::Server(TString configuration_file){
+	/*
+	constructs the Server Class, which keeps the samples in the memory and
+	answers requests on a local socket until it is told to quit; the startup
+	(checks, configuration, configplot and version) is paid only once
+	parameters: configuration_file (path to configuration file)
+	return: none
+	*/
+
+	kVerbose -> Class("Server");
+	Initialize();
+	StartDileptons(configuration_file);
+
+}
+
+
+//____________________________________________________________________________
+Server::~Server(){
+	/*
+	destructs the Server Class
+	parameters: none
+	return: none
+	*/
+
+}
+
+
+//____________________________________________________________________________
+void Server::Initialize(){
+	/*
+	initializes the Server Class
+	parameters: none
+	return: none
+	*/
+
+	kServerSocket = "";
+
+}
+
+
+//____________________________________________________________________________
+void Server::EndDileptons(){
+	/*
+	ends dileptons, closes the samples kept in the memory, copies the outputs
+	and tags the code
+	parameters: none
+	return: none
+	*/
+
+	for(std::map<Label, TFile*>::iterator i = kServerFiles.begin(); i != kServerFiles.end(); ++i){
+		i -> second -> Close();
+		delete i -> second;
+	}
+
+	kServerFiles.clear();
+	kServerTrees.clear();
+
+	Dileptons::EndDileptons();
+
+}
+
+
+//____________________________________________________________________________
+void Server::Serve(){
+	/*
+	loads the samples and answers the requests on the socket, one connection
+	per request, until a request is quit
+	parameters: none
+	return: none
+	*/
+
+	LoadSamples();
+
+
+	// open the socket, a socket left from a server that was killed is removed,
+	// any other file of that name is kept and the server does not start
+
+	kServerSocket = (cServerSocket.Length() > 0) ? cServerSocket : kTemporaryFolder + "server.sock";
+
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if(kServerSocket.Length() >= sizeof(address.sun_path)) kVerbose -> ErrorAndExit(24);
+	strncpy(address.sun_path, kServerSocket.Data(), sizeof(address.sun_path) - 1);
+
+	struct stat status;
+	if(lstat(kServerSocket.Data(), &status) == 0) {
+		if(!S_ISSOCK(status.st_mode)) kVerbose -> ErrorAndExit(24);
+		unlink(kServerSocket.Data());
+	}
+
+	int server_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(server_socket < 0) kVerbose -> ErrorAndExit(24);
+
+	// only the user running the server may send requests, the socket is
+	// created with these permissions already
+	mode_t mask = umask(S_IRWXG | S_IRWXO);
+	int bound   = bind(server_socket, (struct sockaddr *) &address, sizeof(address));
+	umask(mask);
+
+	if(bound < 0 || listen(server_socket, 8) < 0) kVerbose -> ErrorAndExit(24);
+
+	std::cout << ">> SERVING " << kServerTrees.size() << " SAMPLES ON " << kServerSocket << std::endl;
+
+
+	// answer the requests
+
+	while(true){
+
+		int client_socket = accept(server_socket, NULL, NULL);
+		if(client_socket < 0) {
+			if(errno == EINTR) continue;
+			break;
+		}
+
+		// a client that sends nothing does not block the server
+		struct timeval timeout;
+		timeout.tv_sec  = 10;
+		timeout.tv_usec = 0;
+		setsockopt(client_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		setsockopt(client_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+		TString request = ReadRequest(client_socket);
+
+		if(Tools::FindElementInVector(Tools::ExplodeTString(request, "\n"), TString("quit"))) {
+			WriteResponse(client_socket, "quit\n");
+			close(client_socket);
+			break;
+		}
+
+		WriteResponse(client_socket, HandleRequest(request));
+		close(client_socket);
+
+	}
+
+	close(server_socket);
+	if(lstat(kServerSocket.Data(), &status) == 0 && S_ISSOCK(status.st_mode)) unlink(kServerSocket.Data());
+
+	std::cout << ">> SERVER STOPPED" << std::endl;
+
+}
+
+
+
+
+/*****************************************************************************
+******************************************************************************
+** CLASS MEMBERS FOR HANDLING REQUESTS                                      **
+******************************************************************************
+*****************************************************************************/
+
+
+//____________________________________________________________________________
+TString Server::CheckRequest(std::vector<Label> & sample_keys, std::vector<Label> & selection_keys, std::vector<TString> & plots){
+	/*
+	checks the samples, selections, plots and AKROSD strings of a request, the
+	definitions of the request are already added to the configuration; no
+	samples in the request means all samples kept in the memory
+	parameters: sample_keys, selection_keys, plots
+	return: error message (empty if the request is legal)
+	*/
+
+	if(sample_keys.size() == 0) sample_keys = Tools::GetVectorFromMapKeys(kServerTrees);
+
+	for(int i = 0; i < sample_keys.size(); ++i)
+		if(!Tools::FindElementInMapByKey(kServerTrees, sample_keys[i])) return "sample " + sample_keys[i] + " is not kept in the memory of the server";
+
+	if(selection_keys.size() == 0) return "no event selection is requested";
+
+	for(int i = 0; i < selection_keys.size(); ++i)
+		if(!Tools::FindElementInMapByKey(cEventSelectionDefinitions, selection_keys[i])) return "event selection " + selection_keys[i] + " is not defined";
+
+
+	// the AKROSD strings are checked as in the configuration file
+
+	std::vector<Label> selected_objects  = Tools::GetVectorFromMapKeys(cObjectSelectionDefinitions);
+	std::vector<Label> defined_variables = Tools::GetVectorFromMapKeys(cDefinedVariableDefinitions);
+
+	for(std::map<Label, AKROSD>::iterator iterator = cObjectSelectionDefinitions.begin(); iterator != cObjectSelectionDefinitions.end(); ++iterator)
+		if(!CheckAKROSDStringForObjectSelection(iterator->first, iterator->second, selected_objects, defined_variables))
+			return "object selection " + iterator->first + " is illegal";
+
+	for(std::map<Label, AKROSD>::iterator iterator = cDefinedVariableDefinitions.begin(); iterator != cDefinedVariableDefinitions.end(); ++iterator)
+		if(!CheckAKROSDStringForDefinedVariables(iterator->first, iterator->second, selected_objects, defined_variables))
+			return "defined variable " + iterator->first + " is illegal";
+
+	for(std::map<Label, AKROSD>::iterator iterator = cEventSelectionDefinitions.begin(); iterator != cEventSelectionDefinitions.end(); ++iterator)
+		if(!CheckAKROSDStringForEventSelection(iterator->second, selected_objects, defined_variables))
+			return "event selection " + iterator->first + " is illegal";
+
+
+	// plots are <selection>:<variable>:<bins>:<min>:<max>, the variable is
+	// checked as a statement of an event selection
+
+	for(int i = 0; i < plots.size(); ++i){
+		std::vector<TString> plot = Tools::ExplodeTString(plots[i], ":");
+		if(plot.size() != 5 || !plot[2].IsDigit() || plot[2].Atoi() < 1 || plot[2].Atoi() > 10000 || !plot[3].IsFloat() || !plot[4].IsFloat() || plot[4].Atof() <= plot[3].Atof())
+			return "plot " + plots[i] + " is illegal, plots are given as <variable>:<bins>:<min>:<max>";
+		if(!CheckAKROSDStringForEventSelection(plot[1] + ">0", selected_objects, defined_variables))
+			return "plot variable " + plot[1] + " is illegal";
+	}
+
+	return "";
+
+}
+
+
+//____________________________________________________________________________
+TString Server::HandleRequest(TString request){
+	/*
+	answers a request; a request is given in the syntax of the configuration
+	file, object selections (o), defined variables (d) and event selections (e)
+	are added to the configuration for the time of the request and every event
+	selection given is counted; further lines are
+	  n  TString  Samples     <sample>,<sample>         (default: all samples)
+	  n  TString  Selections  <selection>,<selection>   (of the configuration)
+	  p  TString  <selection> <variable>:<bins>:<min>:<max>
+	parameters: request
+	return: response
+	*/
+
+	std::map<Label, AKROSD> object_selections = cObjectSelectionDefinitions;
+	std::map<Label, AKROSD> defined_variables = cDefinedVariableDefinitions;
+	std::map<Label, AKROSD> event_selections  = cEventSelectionDefinitions;
+
+	std::vector<Label> sample_keys;
+	std::vector<Label> selection_keys;
+	std::vector<TString> plots;
+	TString error = "";
+
+	char symbol_char[2], type_char[20], name_char[100], value_char[500], comment_char[300];
+
+	std::vector<TString> lines = Tools::ExplodeTString(request, "\n");
+
+	for(int i = 0; i < lines.size() && error == ""; ++i){
+
+		TString line = lines[i].ReplaceAll("\r", "");
+
+		if(line.Length() == 0 || line(0,1) == "#" || line == "end") continue;
+		if(line.Length() >= 500 || sscanf(line.Data(), "%1s\t%19s\t\t%99s\t\t%499s\t\t%299s", symbol_char, type_char, name_char, value_char, comment_char) < 4) {
+			error = "line " + line + " is illegal";
+			continue;
+		}
+
+		TString symbol = symbol_char;
+		TString type   = type_char;
+		TString name   = name_char;
+		TString value  = value_char;
+
+		if     (symbol == "o" && type == "AKROSD") cObjectSelectionDefinitions[name] = value;
+		else if(symbol == "d" && type == "AKROSD") cDefinedVariableDefinitions[name] = value;
+		else if(symbol == "e" && type == "AKROSD") {
+			cEventSelectionDefinitions[name] = value;
+			if(!Tools::FindElementInVector(selection_keys, name)) selection_keys.push_back(name);
+		}
+		else if(symbol == "n" && type == "TString" && name == "Samples") {
+			std::vector<Label> keys = Tools::ExplodeTString(value, ",");
+			sample_keys.insert(sample_keys.end(), keys.begin(), keys.end());
+		}
+		else if(symbol == "n" && type == "TString" && name == "Selections") {
+			std::vector<Label> keys = Tools::ExplodeTString(value, ",");
+			for(int j = 0; j < keys.size(); ++j)
+				if(!Tools::FindElementInVector(selection_keys, keys[j])) selection_keys.push_back(keys[j]);
+		}
+		else if(symbol == "p" && type == "TString") {
+			plots.push_back(name + ":" + value);
+			if(!Tools::FindElementInVector(selection_keys, name)) selection_keys.push_back(name);
+		}
+		else error = "line " + line + " is illegal";
+
+	}
+
+	if(error == "") error = CheckRequest(sample_keys, selection_keys, plots);
+
+	TString response = (error == "") ? RunRequest(sample_keys, selection_keys, plots) : "error\t" + error + "\n";
+
+
+	// the configuration is restored for the next request
+
+	cObjectSelectionDefinitions = object_selections;
+	cDefinedVariableDefinitions = defined_variables;
+	cEventSelectionDefinitions  = event_selections;
+
+	return response;
+
+}
+
+
+//____________________________________________________________________________
+void Server::LoadSamples(){
+	/*
+	opens the samples given in ServerSamples (default: all samples) and loads
+	their baskets into the memory, at most ServerMemory MB per sample; the
+	baskets are kept compressed, every request only decompresses them
+	parameters: none
+	return: none
+	*/
+
+	std::vector<Label> sample_keys = (cServerSamples.Length() > 0) ? Tools::ExplodeTString(cServerSamples, ",") : Tools::GetVectorFromMapKeys(cSamples);
+
+	for(int i = 0; i < sample_keys.size(); ++i){
+
+		kVerbose -> Sample(sample_keys[i]);
+
+		TFile * root_file = TFile::Open(cSamples[sample_keys[i]] -> GetPath());
+		if(root_file == NULL || root_file -> IsZombie()) kVerbose -> ErrorAndExit(10);
+
+		TTree * tree = (TTree *) root_file -> Get("Analysis");
+		if(tree == NULL) kVerbose -> ErrorAndExit(10);
+
+		if(cServerMemory > 0) tree -> LoadBaskets((Long64_t) cServerMemory * 1000000);
+
+		kServerFiles[sample_keys[i]] = root_file;
+		kServerTrees[sample_keys[i]] = tree;
+
+	}
+
+}
+
+
+//____________________________________________________________________________
+TString Server::ReadRequest(int client_socket){
+	/*
+	reads a request from a connection, the request ends with a line end or
+	quit, when the client closes its side of the connection or when nothing
+	arrives for the receive timeout of the connection
+	parameters: client_socket
+	return: request
+	*/
+
+	std::string request = "";
+	char buffer[4096];
+
+	while(request.size() < 1000000){
+
+		ssize_t bytes = read(client_socket, buffer, sizeof(buffer));
+		if(bytes < 0 && errno == EINTR) continue;
+		if(bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return "";
+		if(bytes <= 0) break;
+
+		request.append(buffer, bytes);
+
+		std::string text = "\n" + request;
+		if(text.find("\nend\n") != std::string::npos || text.find("\nquit\n") != std::string::npos) break;
+
+	}
+
+	return TString(request.c_str());
+
+}
+
+
+//____________________________________________________________________________
+TString Server::RunRequest(std::vector<Label> sample_keys, std::vector<Label> selection_keys, std::vector<TString> plots){
+	/*
+	loops over the samples kept in the memory and counts the events of every
+	selection and fills the plots, as the modules do on the nominal event; the
+	response has one line per count and plot
+	  count      <sample> <selection> <events> <yield>
+	  histogram  <sample> <selection> <variable>:<bins>:<min>:<max> <underflow>,<bins>,<overflow>
+	  time       <seconds>
+	parameters: sample_keys, selection_keys, plots
+	return: response
+	*/
+
+	struct timespec start, stop;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+
+	// the plots are split into selection, variable and binning once
+
+	std::vector<int> plot_selections, plot_bins;
+	std::vector<AKROSD> plot_variables;
+	std::vector<float> plot_minima, plot_maxima;
+
+	for(int i = 0; i < plots.size(); ++i){
+		std::vector<TString> plot = Tools::ExplodeTString(plots[i], ":");
+		plot_selections.push_back(std::find(selection_keys.begin(), selection_keys.end(), plot[0]) - selection_keys.begin());
+		plot_variables .push_back(plot[1]);
+		plot_bins      .push_back(plot[2].Atoi());
+		plot_minima    .push_back(plot[3].Atof());
+		plot_maxima    .push_back(plot[4].Atof());
+	}
+
+	TString response = "";
+
+	// loop over samples
+	for(int s = 0; s < sample_keys.size(); ++s){
+
+		kRootTree = kServerTrees[sample_keys[s]];
+		kRootTree -> ResetBranchAddresses();
+		Base::Initialize(kRootTree);
+
+		cSamples[sample_keys[s]] -> SetEventWeight(cLuminosity);
+
+		std::vector<Long64_t> events(selection_keys.size(), 0);
+		std::vector<double> yields(selection_keys.size(), 0.);
+		std::vector<bool> passed(selection_keys.size(), false);
+		std::vector<std::vector<double> > contents(plots.size());
+		for(int i = 0; i < plots.size(); ++i)
+			contents[i].assign(plot_bins[i] + 2, 0.);
+
+		Long64_t entries = std::min(cSamples[sample_keys[s]] -> GetMaxEntries(), kRootTree -> GetEntries());
+
+		// loop over entries
+		for(Long64_t entry = 0; entry < entries; ++entry){
+
+			kRootTree -> GetEntry(entry);
+
+			float event_weight = cSamples[sample_keys[s]] -> GetEventWeight();
+			if(cPileUpReweighting) event_weight *= PUWeight;
+			ComputeEventWeights(cSamples[sample_keys[s]] -> GetEventWeight(), event_weight);
+
+			PrepareEventSelection();
+
+			for(int j = 0; j < selection_keys.size(); ++j){
+				passed[j] = ParseEventSelection(cEventSelectionDefinitions[selection_keys[j]]);
+				if(!passed[j]) continue;
+				++events[j];
+				yields[j] += kEventWeights[0];
+			}
+
+			for(int i = 0; i < plots.size(); ++i){
+				if(!passed[plot_selections[i]]) continue;
+				float value = ParseAKROSDVariable(plot_variables[i]);
+				if(value != value) continue;
+				int bin = 1 + (int) floor((value - plot_minima[i]) / (plot_maxima[i] - plot_minima[i]) * plot_bins[i]);
+				contents[i][std::max(0, std::min(bin, plot_bins[i] + 1))] += kEventWeights[0];
+			}
+		}
+
+		for(int j = 0; j < selection_keys.size(); ++j)
+			response += Form("count\t%s\t%s\t%lld\t%g\n", sample_keys[s].Data(), selection_keys[j].Data(), (long long) events[j], yields[j]);
+
+		for(int i = 0; i < plots.size(); ++i){
+			TString bins = "";
+			for(int k = 0; k < contents[i].size(); ++k)
+				bins += Form("%s%g", (k == 0 ? "" : ","), contents[i][k]);
+			std::vector<TString> plot = Tools::ExplodeTString(plots[i], ":");
+			response += Form("histogram\t%s\t%s\t%s:%s:%s:%s\t%s\n", sample_keys[s].Data(), plot[0].Data(), plot[1].Data(), plot[2].Data(), plot[3].Data(), plot[4].Data(), bins.Data());
+		}
+
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	response += Form("time\t%.3f\n", (stop.tv_sec - start.tv_sec) + 1.e-9 * (stop.tv_nsec - start.tv_nsec));
+
+	return response;
+
+}
+
+
+//____________________________________________________________________________
+bool Server::WriteResponse(int client_socket, TString response){
+	/*
+	writes the response to a connection, a client that went away does not stop
+	the server
+	parameters: client_socket, response
+	return: true (if written), false (else)
+	*/
+
+	const char * data = response.Data();
+	Ssiz_t written = 0;
+
+	while(written < response.Length()){
+		ssize_t bytes = send(client_socket, data + written, response.Length() - written, MSG_NOSIGNAL);
+		if(bytes < 0 && errno == EINTR) continue;
+		if(bytes <= 0) return false;
+		written += bytes;
+	}
+
+	return true;
+
+}